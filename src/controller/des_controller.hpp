@@ -1,6 +1,8 @@
 #ifndef CRYPTO_CONTROLLER_DES_CONTROLLER_HPP
 #define CRYPTO_CONTROLLER_DES_CONTROLLER_HPP
 
+#include <string>
+#include <vector>
 #include <string_view>
 
 #include "des.hpp"
@@ -12,13 +14,75 @@ public:
     ~DESController() = default;
 
 public:
-    void Encrypt(std::string_view file_path, std::string_view key_path) {
-        rsa_.EncodeECB(file_path, key_path);
+    void Encrypt(std::string_view file_path, std::string_view key_path, DESFormat format = DESFormat::kBinary) {
+        rsa_.EncodeECB(file_path, key_path, format);
     }
 
     void Decrypt(std::string_view file_path, std::string_view key_path) {
         rsa_.DecodeECB(file_path, key_path);
     }
+
+    void EncryptCTR(std::string_view file_path, std::string_view key_path) {
+        rsa_.EncodeCTR(file_path, key_path);
+    }
+
+    void DecryptCTR(std::string_view file_path, std::string_view key_path) {
+        rsa_.DecodeCTR(file_path, key_path);
+    }
+
+    void EncryptCBC(std::string_view file_path, std::string_view key_path) {
+        rsa_.EncodeCBC(file_path, key_path);
+    }
+
+    void EncryptCBC(const std::vector<std::string>& file_paths, std::string_view key_path) {
+        rsa_.EncodeCBC(file_paths, key_path);
+    }
+
+    void DecryptCBC(std::string_view file_path, std::string_view key_path) {
+        rsa_.DecodeCBC(file_path, key_path);
+    }
+
+    void EncryptStream(std::string_view file_path, std::string_view key_path, DESMode mode = DESMode::kCTR) {
+        rsa_.EncodeStream(file_path, key_path, mode);
+    }
+
+    void DecryptStream(std::string_view file_path, std::string_view key_path) {
+        rsa_.DecodeStream(file_path, key_path);
+    }
+
+    void Encrypt3DES(std::string_view file_path, std::string_view key_path, DESMode mode = DESMode::kCBC) {
+        DES3Key key{rsa_.LoadKey3DES(key_path)};
+
+        if (mode == DESMode::kECB)
+            rsa_.EncodeECB(file_path, key);
+        else if (mode == DESMode::kCTR)
+            rsa_.EncodeCTR(file_path, key);
+        else
+            rsa_.EncodeCBC(file_path, key);
+    }
+
+    void Decrypt3DES(std::string_view file_path, std::string_view key_path, DESMode mode = DESMode::kCBC) {
+        DES3Key key{rsa_.LoadKey3DES(key_path)};
+
+        if (mode == DESMode::kECB)
+            rsa_.DecodeECB(file_path, key);
+        else if (mode == DESMode::kCTR)
+            rsa_.DecodeCTR(file_path, key);
+        else
+            rsa_.DecodeCBC(file_path, key);
+    }
+
+    void SetThreads(std::size_t threads) {
+        rsa_.SetThreads(threads);
+    }
+
+    void SetBackend(DESBackend backend) {
+        rsa_.SetBackend(backend);
+    }
+
+    void SetStreamWindow(std::size_t bytes) {
+        rsa_.SetStreamWindow(bytes);
+    }
     
 private:
     DES rsa_;
@@ -28,10 +28,18 @@ public:
         enigma_->Encrypt(path);
     }
 
+    void EncryptResumable(std::string_view path) {
+        enigma_->EncryptResumable(path);
+    }
+
     void SaveConfig(std::string_view dir) {
         enigma_->SaveConfig(dir);
     }
 
+    void SetThreads(std::size_t threads) {
+        enigma_->SetThreads(threads);
+    }
+
 private:
     std::unique_ptr<Enigma> enigma_;
 };
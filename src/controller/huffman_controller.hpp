@@ -16,8 +16,8 @@ public:
         huffman_.Encode(path);
     }
 
-    void Decrypt(std::string_view path_file, std::string_view path_config) {
-        huffman_.Decode(path_file, path_config);
+    void Decrypt(std::string_view path) {
+        huffman_.Decode(path);
     }
     
 private:
@@ -12,17 +12,30 @@ public:
     ~RSAController() = default;
 
 public:
-    void GenerateKeys(std::string_view dir) {
-        rsa_.GenerateKeys(dir);
+    void GenerateKeys(std::string_view dir, std::size_t key_bits = RSA::default_key_bits) {
+        rsa_.GenerateKeys(dir, key_bits);
     }
 
-    void Encrypt(std::string_view file_path, std::string_view key_path) {
-        rsa_.Encode(file_path, key_path);
+    void Encrypt(std::string_view file_path, std::string_view key_path,
+                 RSAMode mode = RSAMode::kByte, RSAFormat format = RSAFormat::kBinary) {
+        rsa_.Encode(file_path, key_path, mode, format);
     }
 
     void Decrypt(std::string_view file_path, std::string_view key_path) {
         rsa_.Decode(file_path, key_path);
     }
+
+    void EncryptEnvelope(std::string_view file_path, std::string_view key_path) {
+        rsa_.EncodeEnvelope(file_path, key_path);
+    }
+
+    void DecryptEnvelope(std::string_view file_path, std::string_view key_path) {
+        rsa_.DecodeEnvelope(file_path, key_path);
+    }
+
+    void SetThreads(std::size_t threads) {
+        rsa_.SetThreads(threads);
+    }
     
 private:
     RSA rsa_;
@@ -0,0 +1,90 @@
+#ifndef CRYPTO_MODEL_COMMON_PARALLEL_HPP
+#define CRYPTO_MODEL_COMMON_PARALLEL_HPP
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <algorithm>
+#include <system_error>
+
+namespace s21 {
+class Parallel {
+public:
+    using size_type = std::size_t;
+
+public:
+    static size_type DefaultThreads() noexcept {
+        size_type threads{std::thread::hardware_concurrency()};
+        return threads ? threads : 1;
+    }
+
+    /*
+        Splits [begin, end) into at most `threads` contiguous ranges of at
+        least `grain` items and calls function(range_begin, range_end) for
+        each of them, the first range on the calling thread. The first
+        exception thrown by a worker is rethrown once all of them finished.
+        A range whose thread cannot be started runs on the calling thread
+        instead, so the workers already running are always joined.
+    */
+    template <typename Function>
+    static void For(size_type begin, size_type end, size_type grain, size_type threads, Function&& function) {
+        if (begin >= end)
+            return;
+
+        size_type count{end - begin};
+        size_type max_chunks{(count + std::max<size_type>(grain, 1) - 1) / std::max<size_type>(grain, 1)};
+        size_type chunks{std::max<size_type>(std::min(threads, max_chunks), 1)};
+
+        if (chunks == 1) {
+            function(begin, end);
+            return;
+        }
+
+        size_type chunk_size{count / chunks};
+        size_type remainder{count % chunks};
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto run{[&](size_type range_begin, size_type range_end) {
+            try {
+                function(range_begin, range_end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }};
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+
+        size_type first_end{begin + chunk_size + (remainder ? 1 : 0)};
+        size_type range_begin{first_end};
+
+        for (size_type i{1}; i < chunks; ++i) {
+            size_type range_end{range_begin + chunk_size + (i < remainder ? 1 : 0)};
+
+            try {
+                workers.emplace_back(run, range_begin, range_end);
+            } catch (const std::system_error&) {
+                run(range_begin, range_end);
+            }
+
+            range_begin = range_end;
+        }
+
+        run(begin, first_end);
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_COMMON_PARALLEL_HPP
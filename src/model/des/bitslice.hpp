@@ -0,0 +1,274 @@
+#ifndef CRYPTO_MODEL_DES_BITSLICE_HPP
+#define CRYPTO_MODEL_DES_BITSLICE_HPP
+
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "core.hpp"
+#include "tables.hpp"
+#include "fast_tables.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRYPTO_DES_HAS_AVX2_PATH 1
+#else
+#define CRYPTO_DES_HAS_AVX2_PATH 0
+#endif
+
+namespace s21 {
+enum class DESBackend : uint8_t { kAuto, kScalar, kBitslice64, kBitslice256 };
+
+/*
+    Bitsliced DES: a batch of blocks is transposed into 64 bit-planes
+    (plane i holds bit i of every block), so IP, E, P and FP become plane
+    renumbering and the S-boxes are evaluated as boolean circuits over
+    whole planes. A uint64_t plane carries 64 blocks; the AVX2 path uses
+    256-bit planes (4 x uint64_t lanes) for 256 blocks per pass.
+*/
+class DESBitslice {
+public:
+    using size_type     = std::size_t;
+    using schedule_type = DESCore::schedule_type;
+
+public:
+    static constexpr const size_type batch_64{64};
+    static constexpr const size_type batch_256{256};
+
+public:
+    static bool HasAVX2() noexcept {
+#if CRYPTO_DES_HAS_AVX2_PATH
+        static const bool has_avx2{__builtin_cpu_supports("avx2") != 0};
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    /*
+        kAuto picks the widest engine the CPU supports.
+    */
+    static DESBackend Resolve(DESBackend backend) noexcept {
+        if (backend == DESBackend::kAuto)
+            return HasAVX2() ? DESBackend::kBitslice256 : DESBackend::kBitslice64;
+
+        if (backend == DESBackend::kBitslice256 && !HasAVX2())
+            return DESBackend::kBitslice64;
+
+        return backend;
+    }
+
+    static size_type BatchSize(DESBackend backend) noexcept {
+        switch (Resolve(backend)) {
+            case DESBackend::kBitslice64:  return batch_64;
+            case DESBackend::kBitslice256: return batch_256;
+            default:                       return 1;
+        }
+    }
+
+    /*
+        Encrypts or decrypts (depending on the schedule) `count` blocks in
+        place; count may be anything up to BatchSize(backend).
+    */
+    template <std::size_t N>
+    static void Crypt(DESBackend backend, uint64_t* blocks, size_type count, const std::array<uint64_t, N>& schedule) {
+        switch (Resolve(backend)) {
+            case DESBackend::kBitslice64:
+                Crypt64(blocks, count, schedule);
+                break;
+#if CRYPTO_DES_HAS_AVX2_PATH
+            case DESBackend::kBitslice256:
+                Crypt256(blocks, count, schedule);
+                break;
+#endif
+            default:
+                for (size_type i{}; i < count; ++i)
+                    blocks[i] = DESCore::Crypt(blocks[i], schedule);
+                break;
+        }
+    }
+
+    template <std::size_t N>
+    static void Crypt64(uint64_t* blocks, size_type count, const std::array<uint64_t, N>& schedule) {
+        uint64_t planes[64]{};
+        uint64_t key_masks[N * 48];
+
+        std::copy(blocks, blocks + std::min(count, batch_64), planes);
+        Transpose(planes);
+
+        MakeKeyMasks(schedule, key_masks);
+        CryptPlanes<N>(planes, key_masks);
+
+        Transpose(planes);
+        std::copy(planes, planes + std::min(count, batch_64), blocks);
+    }
+
+#if CRYPTO_DES_HAS_AVX2_PATH
+    template <std::size_t N>
+    __attribute__((target("avx2")))
+    static void Crypt256(uint64_t* blocks, size_type count, const std::array<uint64_t, N>& schedule) {
+        uint64_t lanes[4][64]{};
+        word256 planes[64];
+        word256 key_masks[N * 48];
+
+        count = std::min(count, batch_256);
+
+        for (size_type lane{}; lane < 4 && lane * 64 < count; ++lane) {
+            std::copy(blocks + lane * 64, blocks + std::min(count, lane * 64 + 64), lanes[lane]);
+            Transpose(lanes[lane]);
+        }
+
+        for (size_type i{}; i < 64; ++i)
+            planes[i] = word256{lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i]};
+
+        MakeKeyMasks(schedule, key_masks);
+        CryptPlanes<N>(planes, key_masks);
+
+        for (size_type i{}; i < 64; ++i)
+            for (size_type lane{}; lane < 4; ++lane)
+                lanes[lane][i] = planes[i][lane];
+
+        for (size_type lane{}; lane < 4 && lane * 64 < count; ++lane) {
+            Transpose(lanes[lane]);
+            std::copy(lanes[lane], lanes[lane] + std::min<size_type>(count - lane * 64, 64), blocks + lane * 64);
+        }
+    }
+#endif
+
+private:
+#if CRYPTO_DES_HAS_AVX2_PATH
+    typedef uint64_t word256 __attribute__((vector_size(32)));
+#endif
+
+    /*
+        In-place 64x64 bit-matrix transpose: afterwards bit k of a[j] is
+        what bit j of a[k] was.
+    */
+    static void Transpose(uint64_t* a) noexcept {
+        uint64_t mask{0x00000000FFFFFFFFULL};
+
+        for (unsigned j{32}; j; j >>= 1, mask ^= mask << j) {
+            for (unsigned k{}; k < 64; k = ((k | j) + 1) & ~j) {
+                uint64_t t{((a[k] >> j) ^ a[k | j]) & mask};
+                a[k | j] ^= t;
+                a[k] ^= t << j;
+            }
+        }
+    }
+
+    /*
+        Round r, S-box b, group bit j -> all-zero or all-one plane.
+    */
+    template <typename Word, std::size_t N>
+    __attribute__((always_inline))
+    static inline void MakeKeyMasks(const std::array<uint64_t, N>& schedule, Word* key_masks) noexcept {
+        for (size_type r{}; r < N; ++r)
+            for (size_type bit{}; bit < 48; ++bit)
+                key_masks[r * 48 + bit] = ((schedule[r] >> ((bit / 6) * 8 + bit % 6)) & 1) ? ~Word{} : Word{};
+    }
+
+    /*
+        S-box B as straight-line code: the term lists from fast_tables.hpp
+        are expanded at compile time, so only the XORs of the set minterms
+        remain.
+    */
+    template <size_type B, size_type T, size_type C, typename Word, size_type... K>
+    __attribute__((always_inline))
+    static inline void SBoxPart(const Word* minterm, const Word& high, Word& out, std::index_sequence<K...>) noexcept {
+        Word part{};
+        ((part ^= minterm[tbl::gen::sbox_terms.index[B][T][C][K]]), ...);
+        out ^= part & high;
+    }
+
+    template <size_type B, size_type T, typename Word, size_type... C>
+    __attribute__((always_inline))
+    static inline void SBoxOutput(const Word* minterm, const Word* high, Word& out, std::index_sequence<C...>) noexcept {
+        out = Word{};
+        (SBoxPart<B, T, C>(minterm, high[C], out, std::make_index_sequence<tbl::gen::sbox_terms.count[B][T][C]>{}), ...);
+    }
+
+    template <size_type B, typename Word>
+    __attribute__((always_inline))
+    static inline void SBox(const Word* in, Word* out) noexcept {
+        Word low[4], middle[4], high[4];
+        Word inverted[6];
+
+        for (size_type j{}; j < 6; ++j)
+            inverted[j] = ~in[j];
+
+        for (size_type v{}; v < 4; ++v) {
+            low[v] = (v & 1 ? in[0] : inverted[0]) & (v & 2 ? in[1] : inverted[1]);
+            middle[v] = (v & 1 ? in[2] : inverted[2]) & (v & 2 ? in[3] : inverted[3]);
+            high[v] = (v & 1 ? in[4] : inverted[4]) & (v & 2 ? in[5] : inverted[5]);
+        }
+
+        Word minterm[16];
+        for (size_type v{}; v < 16; ++v)
+            minterm[v] = low[v & 3] & middle[v >> 2];
+
+        SBoxOutput<B, 0>(minterm, high, out[0], std::make_index_sequence<4>{});
+        SBoxOutput<B, 1>(minterm, high, out[1], std::make_index_sequence<4>{});
+        SBoxOutput<B, 2>(minterm, high, out[2], std::make_index_sequence<4>{});
+        SBoxOutput<B, 3>(minterm, high, out[3], std::make_index_sequence<4>{});
+    }
+
+    template <size_type B, typename Word>
+    __attribute__((always_inline))
+    static inline void FeistelBox(const Word* half, Word* target, const Word* key_masks) noexcept {
+        constexpr unsigned shift{tbl::gen::expansion_shifts[B]};
+        Word in[6], out[4];
+
+        for (size_type j{}; j < 6; ++j)
+            in[j] = half[(shift + j) & 31] ^ key_masks[B * 6 + j];
+
+        SBox<B>(in, out);
+
+        for (size_type t{}; t < 4; ++t)
+            target[tbl::gen::permutation_inverse[28 - B * 4 + t]] ^= out[t];
+    }
+
+    /*
+        target ^= P(S(E(half) ^ round_key))
+    */
+    template <typename Word, size_type... B>
+    __attribute__((always_inline))
+    static inline void Feistel(const Word* half, Word* target, const Word* key_masks, std::index_sequence<B...>) noexcept {
+        (FeistelBox<B>(half, target, key_masks), ...);
+    }
+
+    /*
+        N / 16 DES stages back to back (see DESCore::Crypt); swapping the
+        halves between stages is just swapping the plane arrays.
+    */
+    template <std::size_t N, typename Word>
+    __attribute__((always_inline))
+    static inline void CryptPlanes(Word* planes, const Word* key_masks) noexcept {
+        Word left_planes[32], right_planes[32];
+        Word* left{left_planes};
+        Word* right{right_planes};
+
+        for (size_type i{}; i < 32; ++i) {
+            right[i] = planes[tbl::gen::internal_initial_permutation[i] - 1];
+            left[i] = planes[tbl::gen::internal_initial_permutation[32 + i] - 1];
+        }
+
+        for (size_type stage{}; stage < N; stage += DESCore::num_rounds) {
+            if (stage)
+                std::swap(left, right);
+
+            for (size_type r{stage}; r < stage + DESCore::num_rounds; r += 2) {
+                Feistel(right, left, key_masks + r * 48, std::make_index_sequence<8>{});
+                Feistel(left, right, key_masks + (r + 1) * 48, std::make_index_sequence<8>{});
+            }
+        }
+
+        for (size_type i{}; i < 64; ++i) {
+            size_type source{static_cast<size_type>(tbl::gen::internal_final_permutation[i] - 1)};
+            planes[i] = source < 32 ? left[source] : right[source - 32];
+        }
+    }
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_BITSLICE_HPP
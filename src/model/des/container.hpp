@@ -0,0 +1,212 @@
+#ifndef CRYPTO_MODEL_DES_CONTAINER_HPP
+#define CRYPTO_MODEL_DES_CONTAINER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <string_view>
+
+#include "core.hpp"
+
+namespace s21 {
+enum class DESFormat : uint8_t { kBinary, kText };
+
+enum class DESMode : uint8_t { kECB = 1, kCTR = 2, kCBC = 3 };
+
+enum class DESPadding : uint8_t { kZero = 0, kPKCS7 = 1, kNone = 2 };
+
+enum class DESCipher : uint8_t { kDES = 0, k3DES = 1 };
+
+struct DESHeader {
+    uint8_t version{1};
+    DESMode mode{DESMode::kECB};
+    DESPadding padding{DESPadding::kPKCS7};
+    DESCipher cipher{DESCipher::kDES};
+    uint64_t length{};
+    uint64_t iv{};
+};
+
+/*
+    Binary ciphertext container:
+
+        offset  size  field
+        0       4     magic "S21D"
+        4       1     version
+        5       1     mode
+        6       1     padding scheme
+        7       1     cipher (0 = DES, 1 = 3DES EDE)
+        8       8     original length, little-endian
+        16      8     IV / initial counter, little-endian (CTR and CBC)
+        ...     ...   raw 8-byte blocks (DESCore::Store byte order)
+
+    Stream modes (CTR) use DESPadding::kNone and store exactly `length`
+    body bytes.
+*/
+class DESContainer {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type header_size{16};
+    static constexpr const size_type iv_size{8};
+    static constexpr const uint8_t version{1};
+
+public:
+    static bool HasIV(DESMode mode) noexcept {
+        return mode != DESMode::kECB;
+    }
+
+    static size_type BodyOffset(DESMode mode) noexcept {
+        return header_size + (HasIV(mode) ? iv_size : 0);
+    }
+
+    static bool IsContainer(std::string_view data) noexcept {
+        return data.size() >= header_size && data.substr(0, magic_.size()) == magic_;
+    }
+
+    static void WriteHeader(const DESHeader& header, char* out) noexcept {
+        std::memcpy(out, magic_.data(), magic_.size());
+        out[4] = static_cast<char>(header.version);
+        out[5] = static_cast<char>(header.mode);
+        out[6] = static_cast<char>(header.padding);
+        out[7] = static_cast<char>(header.cipher);
+
+        WriteWord(header.length, out + 8);
+
+        if (HasIV(header.mode))
+            WriteWord(header.iv, out + header_size);
+    }
+
+    /*
+        Whole container in memory: the header plus a body size check.
+    */
+    static DESHeader ReadHeader(std::string_view data) {
+        DESHeader header{ParseHeader(data)};
+
+        CheckBodySize(header, data.size());
+
+        return header;
+    }
+
+    /*
+        Header fields only; `data` must hold at least BodyOffset(mode)
+        bytes, the body may be elsewhere (streaming).
+    */
+    static DESHeader ParseHeader(std::string_view data) {
+        if (!IsContainer(data))
+            throw std::invalid_argument("Not a DES container");
+
+        DESHeader header;
+        header.version = static_cast<uint8_t>(data[4]);
+        header.mode = static_cast<DESMode>(data[5]);
+        header.padding = static_cast<DESPadding>(data[6]);
+        header.cipher = static_cast<DESCipher>(data[7]);
+
+        header.length = ReadWord(data.data() + 8);
+
+        if (header.version != version)
+            throw std::invalid_argument("Unsupported DES container version: " + std::to_string(header.version));
+
+        if (header.mode != DESMode::kECB && header.mode != DESMode::kCTR && header.mode != DESMode::kCBC)
+            throw std::invalid_argument("Unknown DES mode");
+
+        if (header.padding != DESPadding::kZero && header.padding != DESPadding::kPKCS7 && header.padding != DESPadding::kNone)
+            throw std::invalid_argument("Unknown DES padding scheme");
+
+        if (header.padding == DESPadding::kNone && header.mode != DESMode::kCTR)
+            throw std::invalid_argument("Corrupted DES container: block mode without padding");
+
+        if (header.cipher != DESCipher::kDES && header.cipher != DESCipher::k3DES)
+            throw std::invalid_argument("Unknown DES cipher");
+
+        size_type body_offset{BodyOffset(header.mode)};
+        if (data.size() < body_offset)
+            throw std::invalid_argument("Corrupted DES container: truncated header");
+
+        if (HasIV(header.mode))
+            header.iv = ReadWord(data.data() + header_size);
+
+        return header;
+    }
+
+    static void CheckBodySize(const DESHeader& header, uint64_t container_size) {
+        uint64_t body_offset{BodyOffset(header.mode)};
+
+        if (container_size < body_offset || container_size - body_offset != PaddedSize(header.length, header.padding))
+            throw std::invalid_argument("Corrupted DES container: body size does not match header");
+    }
+
+public:
+    /*
+        PKCS#7 always appends 1..8 bytes, zero padding only fills the last
+        partial block (the header length tells where the data ends).
+    */
+    static size_type PaddedSize(uint64_t length, DESPadding padding) noexcept {
+        size_type size{static_cast<size_type>(length)};
+
+        if (padding == DESPadding::kNone)
+            return size;
+
+        if (padding == DESPadding::kPKCS7)
+            return (size / DESCore::block_size + 1) * DESCore::block_size;
+
+        return (size + DESCore::block_size - 1) / DESCore::block_size * DESCore::block_size;
+    }
+
+    /*
+        Builds the padded final block from the 0..7 trailing bytes; returns
+        false when zero padding needs no extra block.
+    */
+    static bool PadTail(const char* tail, size_type tail_size, DESPadding padding, char* block) noexcept {
+        if (padding == DESPadding::kZero && !tail_size)
+            return false;
+
+        char fill{padding == DESPadding::kPKCS7 ? static_cast<char>(DESCore::block_size - tail_size) : '\0'};
+
+        std::memcpy(block, tail, tail_size);
+        std::memset(block + tail_size, fill, DESCore::block_size - tail_size);
+
+        return true;
+    }
+
+    /*
+        Checks the PKCS#7 padding of the decrypted final block against the
+        header length.
+    */
+    static void CheckPadding(const char* last_block, const DESHeader& header) {
+        if (header.padding != DESPadding::kPKCS7)
+            return;
+
+        size_type fill{static_cast<unsigned char>(last_block[DESCore::block_size - 1])};
+        bool is_correct{fill >= 1 && fill <= DESCore::block_size && fill == DESCore::block_size - header.length % DESCore::block_size};
+
+        for (size_type i{DESCore::block_size - fill}; is_correct && i < DESCore::block_size; ++i)
+            is_correct = static_cast<unsigned char>(last_block[i]) == fill;
+
+        if (!is_correct)
+            throw std::invalid_argument("Invalid DES padding (wrong key or corrupted file)");
+    }
+
+private:
+    static void WriteWord(uint64_t value, char* out) noexcept {
+        for (size_type i{}; i < 8; ++i)
+            out[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+
+    static uint64_t ReadWord(const char* data) noexcept {
+        uint64_t value{};
+
+        for (size_type i{}; i < 8; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (i * 8);
+
+        return value;
+    }
+
+private:
+    static constexpr const std::string_view magic_{"S21D"};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_CONTAINER_HPP
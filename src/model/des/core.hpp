@@ -0,0 +1,158 @@
+#ifndef CRYPTO_MODEL_DES_CORE_HPP
+#define CRYPTO_MODEL_DES_CORE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "tables.hpp"
+#include "fast_tables.hpp"
+
+namespace s21 {
+/*
+    Integer DES block core: the state lives in uint64_t/uint32_t words,
+    IP/FP go through byte-indexed tables and every round through eight
+    combined S-box + P-permutation lookups (see fast_tables.hpp).
+*/
+class DESCore {
+public:
+    using block_type    = uint64_t;
+    using half_type     = uint32_t;
+    using schedule_type = std::array<uint64_t, 16>;
+
+    /*
+        Three schedules back to back (3DES EDE), run as one 48-round pass.
+    */
+    using triple_schedule_type = std::array<uint64_t, 48>;
+
+private:
+    using permutation_lookup_t = tbl::gen::permutation_lookup_t;
+
+public:
+    static constexpr const std::size_t block_size{8};
+    static constexpr const std::size_t num_rounds{16};
+
+public:
+    /*
+        FIPS 46-3 key schedule (PC-1, C/D rotations, PC-2) on a key whose
+        standard bit p is bit 64 - p. Byte b of a round key holds the 6-bit
+        key group of S-box b, bit j being round key bit 6b + j + 1.
+    */
+    static schedule_type GenerateSchedule(uint64_t key) noexcept {
+        schedule_type schedule{};
+        uint64_t key_permuted{tbl::gen::permute_standard(key, tbl::key_permutation_table, 56, 64)};
+
+        uint32_t left_key_half{static_cast<uint32_t>(key_permuted >> key_half_bits_size_)};
+        uint32_t right_key_half{static_cast<uint32_t>(key_permuted & key_half_mask_)};
+
+        for (std::size_t i{}; i < num_rounds; ++i) {
+            left_key_half = RotateKeyHalf(left_key_half, tbl::key_shift_table[i]);
+            right_key_half = RotateKeyHalf(right_key_half, tbl::key_shift_table[i]);
+
+            uint64_t combined{(static_cast<uint64_t>(left_key_half) << key_half_bits_size_) | right_key_half};
+            uint64_t compressed{tbl::gen::permute_standard(combined, tbl::key_compression_table, 48, 56)};
+
+            uint64_t packed{};
+            for (std::size_t b{}; b < sbox_count_; ++b)
+                for (std::size_t j{}; j < 6; ++j)
+                    packed |= ((compressed >> (47 - b * 6 - j)) & 1) << (b * 8 + j);
+
+            schedule[i] = packed;
+        }
+
+        return schedule;
+    }
+
+    template <std::size_t N>
+    static std::array<uint64_t, N> ReverseSchedule(const std::array<uint64_t, N>& schedule) noexcept {
+        std::array<uint64_t, N> reversed{};
+
+        for (std::size_t i{}; i < N; ++i)
+            reversed[i] = schedule[N - 1 - i];
+
+        return reversed;
+    }
+
+    /*
+        Encrypts with a forward schedule, decrypts with a reversed one. A
+        schedule of several 16-round stages runs them back to back: FP of
+        one stage and IP of the next cancel out, only the halves swap.
+    */
+    template <std::size_t N>
+    static uint64_t Crypt(uint64_t block, const std::array<uint64_t, N>& schedule) noexcept {
+        static_assert(N && N % num_rounds == 0, "Schedule must consist of whole 16-round stages");
+
+        uint64_t permuted{Permute(block, tbl::gen::initial_permutation_lookup)};
+
+        half_type left_half{static_cast<half_type>(permuted >> 32)};
+        half_type right_half{static_cast<half_type>(permuted)};
+
+        for (std::size_t stage{}; stage < N; stage += num_rounds) {
+            if (stage)
+                std::swap(left_half, right_half);
+
+            for (std::size_t i{stage}; i < stage + num_rounds; i += 2) {
+                left_half ^= Feistel(right_half, schedule[i]);
+                right_half ^= Feistel(left_half, schedule[i + 1]);
+            }
+        }
+
+        return Permute((static_cast<uint64_t>(right_half) << 32) | left_half, tbl::gen::final_permutation_lookup);
+    }
+
+    /*
+        Big-endian, as in FIPS 46-3: byte j of the input lands in bits
+        [56 - 8j, 63 - 8j], missing bytes are zero.
+    */
+    static uint64_t Load(const char* data, std::size_t size) noexcept {
+        uint64_t block{};
+
+        for (std::size_t i{}; i < size && i < block_size; ++i)
+            block |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (56 - i * 8);
+
+        return block;
+    }
+
+    static void Store(uint64_t block, char* data) noexcept {
+        for (std::size_t i{}; i < block_size; ++i)
+            data[i] = static_cast<char>((block >> (56 - i * 8)) & 0xFF);
+    }
+
+private:
+    static half_type Feistel(half_type half, uint64_t round_key) noexcept {
+        half_type result{};
+
+        for (std::size_t b{}; b < sbox_count_; ++b) {
+            half_type group{Rotate(half, tbl::gen::expansion_shifts[b]) & 0x3F};
+            result |= tbl::gen::sp_lookup[b][group ^ ((round_key >> (b * 8)) & 0x3F)];
+        }
+
+        return result;
+    }
+
+    static uint64_t Permute(uint64_t input, const permutation_lookup_t& table) noexcept {
+        uint64_t result{};
+
+        for (std::size_t i{}; i < block_size; ++i)
+            result |= table[i][(input >> (i * 8)) & 0xFF];
+
+        return result;
+    }
+
+    static half_type Rotate(half_type value, unsigned shift) noexcept {
+        return shift ? (value >> shift) | (value << (32 - shift)) : value;
+    }
+
+    static uint32_t RotateKeyHalf(uint32_t value, int shift) noexcept {
+        return ((value << shift) | (value >> (key_half_bits_size_ - shift))) & key_half_mask_;
+    }
+
+private:
+    static constexpr const std::size_t sbox_count_{8};
+    static constexpr const int key_half_bits_size_{28};
+    static constexpr const uint32_t key_half_mask_{0x0FFFFFFF};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_CORE_HPP
@@ -3,195 +3,530 @@
 
 #include <vector>
 #include <bitset>
+#include <fstream>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <random>
 #include <string_view>
+#include <type_traits>
 
-#include "tables.hpp"
+#include "core.hpp"
+#include "key.hpp"
+#include "modes.hpp"
+#include "stream.hpp"
+#include "container.hpp"
+#include "parallel.hpp"
 
 #include "tools.hpp"
 
 namespace s21 {
 class DES {
+public:
+    using key_pointer = DESKeyCache::key_pointer;
+
 private:
     using file_t = tools::filesystem::file_t;
 
+    /*
+        The key-taking overloads accept a DESKey or a DES3Key.
+    */
+    template <typename Key>
+    using enable_if_key_t = std::enable_if_t<std::is_same_v<Key, DESKey> || std::is_same_v<Key, DES3Key>>;
+
 public:
     DES() = default;
     ~DES() = default;
 
 public:
-    void EncodeECB(std::string_view file_path, std::string_view key_path) {
+    void EncodeECB(std::string_view file_path, std::string_view key_path,
+                   DESFormat format = DESFormat::kBinary, DESPadding padding = DESPadding::kPKCS7) {
+        EncodeECB(file_path, *LoadKey(key_path), format, padding);
+    }
+
+    void DecodeECB(std::string_view file_path, std::string_view key_path) {
+        DecodeECB(file_path, *LoadKey(key_path));
+    }
+
+    void EncodeCTR(std::string_view file_path, std::string_view key_path) {
+        EncodeCTR(file_path, *LoadKey(key_path));
+    }
+
+    void DecodeCTR(std::string_view file_path, std::string_view key_path) {
+        DecodeCTR(file_path, *LoadKey(key_path));
+    }
+
+    void EncodeCBC(std::string_view file_path, std::string_view key_path) {
+        EncodeCBC(file_path, *LoadKey(key_path));
+    }
+
+    void EncodeCBC(const std::vector<std::string>& file_paths, std::string_view key_path) {
+        EncodeCBC(file_paths, *LoadKey(key_path));
+    }
+
+    void DecodeCBC(std::string_view file_path, std::string_view key_path) {
+        DecodeCBC(file_path, *LoadKey(key_path));
+    }
+
+    void EncodeStream(std::string_view file_path, std::string_view key_path, DESMode mode = DESMode::kCTR) {
+        EncodeStream(file_path, *LoadKey(key_path), mode);
+    }
+
+    void DecodeStream(std::string_view file_path, std::string_view key_path) {
+        DecodeStream(file_path, *LoadKey(key_path));
+    }
+
+    /*
+        kBinary writes a DESContainer, kText the legacy '0'/'1' format
+        (8 output characters per input bit, zero-filled final block).
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void EncodeECB(std::string_view file_path, const Key& key,
+                   DESFormat format = DESFormat::kBinary, DESPadding padding = DESPadding::kPKCS7) {
         auto file{fsm_.read_file(fs::path(file_path))};
-        auto key_file{fsm_.read_file(fs::path(key_path))};
+        std::string file_text{file.get_text()};
+
+        std::string encrypted_text;
+        if (format == DESFormat::kText)
+            encrypted_text = EncryptTextECB(file_text, key);
+        else
+            encrypted_text = EncryptECB(file_text, key, padding);
 
-        std::bitset<key_bits_size_> key{key_file.get_text()};
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_encoded"), encrypted_text));
+    }
+
+    /*
+        The format is detected from the file: containers start with a magic
+        header, anything else is treated as legacy text.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void DecodeECB(std::string_view file_path, const Key& key) {
+        auto file{fsm_.read_file(fs::path(file_path))};
         std::string file_text{file.get_text()};
-        std::size_t file_size{file.size()};
-        std::vector<std::string> encrypted_blocks;
 
-        for (std::size_t i{}; i < file_size; i += char_bits_size_) {
-            std::bitset<block_bits_size_> block_bits;
-            std::string block_str{file_text.substr(i, char_bits_size_)};
+        std::string decrypted_text;
+        if (DESContainer::IsContainer(file_text))
+            decrypted_text = DecryptECB(file_text, key);
+        else
+            decrypted_text = DecryptTextECB(file_text, key);
 
-            for (std::size_t j{}; j < block_str.size(); ++j) {
-                std::bitset<char_bits_size_> char_bits(block_str[j]);
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), decrypted_text));
+    }
 
-                for (std::size_t k{}; k < char_bits.size(); ++k)
-                    block_bits[j * char_bits_size_ + k] = char_bits[k];
-            }
+    /*
+        CTR needs no padding: the body is exactly as long as the input and
+        starts after a random 64-bit initial counter stored in the header.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void EncodeCTR(std::string_view file_path, const Key& key) {
+        auto file{fsm_.read_file(fs::path(file_path))};
 
-            encrypted_blocks.push_back(EncryptBlock(block_bits, key));
-        }
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_encoded"), EncryptCTR(file.get_text(), key)));
+    }
 
-        std::string encrypted_text{std::accumulate(encrypted_blocks.begin(), encrypted_blocks.end(), std::string(""))};
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void DecodeCTR(std::string_view file_path, const Key& key) {
+        auto file{fsm_.read_file(fs::path(file_path))};
 
-        fsm_.create_file(file_t(GetNewFilePath(file_path, "_encoded"), encrypted_text));
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), DecryptCTR(file.get_text(), key)));
     }
 
-    void DecodeECB(std::string_view file_path, std::string_view key_path) {
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void EncodeCBC(std::string_view file_path, const Key& key) {
+        EncodeCBC(std::vector<std::string>{std::string(file_path)}, key);
+    }
+
+    /*
+        CBC (PKCS#7 padding, random IV in the header). The files are
+        encrypted together as independent interleaved streams, which hides
+        the serial block-to-block dependency of CBC encryption.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void EncodeCBC(const std::vector<std::string>& file_paths, const Key& key) {
+        std::vector<std::string> containers;
+        containers.reserve(file_paths.size());
+
+        for (const auto& file_path : file_paths)
+            containers.push_back(PrepareCBC(fsm_.read_file(fs::path(file_path)).get_text(), CipherOf(key)));
+
+        EncryptCBC(containers, key);
+
+        for (std::size_t i{}; i < file_paths.size(); ++i)
+            fsm_.create_file(file_t(GetNewFilePath(file_paths[i], "_encoded"), containers[i]));
+    }
+
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void DecodeCBC(std::string_view file_path, const Key& key) {
         auto file{fsm_.read_file(fs::path(file_path))};
-        auto key_file{fsm_.read_file(fs::path(key_path))};
 
-        std::bitset<key_bits_size_> key{key_file.get_text()};
-        std::string file_text{file.get_text()};
-        std::size_t file_size{file.size()};
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), DecryptCBC(file.get_text(), key)));
+    }
 
-        std::vector<std::string> decrypted_blocks;
+    /*
+        Constant-memory variants for files larger than RAM: the file is
+        never loaded whole but processed in windows of GetStreamWindow()
+        bytes. The output is the regular container, so DecodeECB/CTR/CBC
+        read it as well, and DecodeStream reads theirs.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void EncodeStream(std::string_view file_path, const Key& key, DESMode mode = DESMode::kCTR) {
+        std::ifstream in{OpenInput(file_path)};
+        std::ofstream out{OpenOutput(GetNewFilePath(file_path, "_encoded"))};
+
+        DESHeader header;
+        header.mode = mode;
+        header.padding = mode == DESMode::kCTR ? DESPadding::kNone : DESPadding::kPKCS7;
+        header.cipher = CipherOf(key);
+        header.length = fs::file_size(fs::path(file_path));
+        header.iv = DESContainer::HasIV(mode) ? GenerateIV() : 0;
+
+        DESStream(stream_window_, threads_, backend_).Encrypt(in, out, header, key.EncryptSchedule());
+    }
 
-        for (std::size_t i{}; i < file_size; i += block_bits_size_) {
-            std::string block_str{file_text.substr(i, block_bits_size_)};
-            std::bitset<block_bits_size_> block_bits(block_str);
+    /*
+        The mode is taken from the container header.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    void DecodeStream(std::string_view file_path, const Key& key) {
+        std::ifstream in{OpenInput(file_path)};
+
+        char header_data[DESContainer::header_size + DESContainer::iv_size]{};
+        in.read(header_data, DESContainer::header_size);
 
-            decrypted_blocks.push_back(DecryptBlock(block_bits, key));
+        std::size_t header_size{static_cast<std::size_t>(in.gcount())};
+        if (header_size == DESContainer::header_size && DESContainer::HasIV(static_cast<DESMode>(header_data[5]))) {
+            in.read(header_data + header_size, DESContainer::iv_size);
+            header_size += static_cast<std::size_t>(in.gcount());
         }
 
-        std::string decrypted_text{std::accumulate(decrypted_blocks.begin(), decrypted_blocks.end(), std::string(""))};
+        DESHeader header{DESContainer::ParseHeader(std::string_view(header_data, header_size))};
+        DESContainer::CheckBodySize(header, fs::file_size(fs::path(file_path)));
+        CheckHeader(header, header.mode, key);
 
-        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), decrypted_text));
+        std::ofstream out{OpenOutput(GetNewFilePath(file_path, "_decoded"))};
+        DESStream stream(stream_window_, threads_, backend_);
+
+        if (header.mode == DESMode::kCTR)
+            stream.Decrypt(in, out, header, key.EncryptSchedule());
+        else
+            stream.Decrypt(in, out, header, key.DecryptSchedule());
+    }
+
+public:
+    /*
+        In-memory variants for callers that manage keys and files
+        themselves: text in, container out, and back.
+    */
+    template <typename Key, typename = enable_if_key_t<Key>>
+    std::string Encrypt(std::string_view text, const Key& key, DESMode mode = DESMode::kCTR) {
+        if (mode == DESMode::kECB)
+            return EncryptECB(text, key, DESPadding::kPKCS7);
+
+        if (mode == DESMode::kCTR)
+            return EncryptCTR(text, key);
+
+        std::vector<std::string> containers{PrepareCBC(text, CipherOf(key))};
+        EncryptCBC(containers, key);
+
+        return std::move(containers.front());
+    }
+
+    template <typename Key, typename = enable_if_key_t<Key>>
+    std::string Decrypt(std::string_view data, const Key& key) {
+        DESMode mode{DESContainer::ReadHeader(data).mode};
+
+        if (mode == DESMode::kECB)
+            return DecryptECB(data, key);
+
+        if (mode == DESMode::kCTR)
+            return DecryptCTR(data, key);
+
+        return DecryptCBC(data, key);
+    }
+
+public:
+    /*
+        Number of worker threads used by the block modes (hardware
+        concurrency by default).
+    */
+    void SetThreads(std::size_t threads) noexcept {
+        threads_ = threads ? threads : 1;
+    }
+
+    std::size_t GetThreads() const noexcept { return threads_; }
+
+    /*
+        Block engine for the parallel modes (ECB, CTR, CBC decryption).
+        kAuto selects the bitsliced engine, 256 blocks per pass with AVX2.
+    */
+    void SetBackend(DESBackend backend) noexcept {
+        backend_ = backend;
+    }
+
+    DESBackend GetBackend() const noexcept { return backend_; }
+
+    /*
+        Window of the streaming modes, rounded down to whole blocks; two
+        windows are the whole memory footprint of EncodeStream/DecodeStream.
+    */
+    void SetStreamWindow(std::size_t bytes) noexcept {
+        stream_window_ = DESStream(bytes).Window();
+    }
+
+    std::size_t GetStreamWindow() const noexcept { return stream_window_; }
+
+    /*
+        Expanded keys are cached by value, so re-using a key file (or another
+        file holding the same key) never expands the schedules again.
+    */
+    key_pointer LoadKey(std::string_view key_path) {
+        auto key_file{fsm_.read_file(fs::path(key_path))};
+
+        if (key_file.empty())
+            throw std::invalid_argument("Cannot read DES key: " + std::string(key_path));
+
+        return key_cache_.Get(key_file.get_text());
+    }
+
+    /*
+        3DES key file: 64, 128 or 192 key bits (see DES3Key::Parse).
+    */
+    DES3Key LoadKey3DES(std::string_view key_path) {
+        auto key_file{fsm_.read_file(fs::path(key_path))};
+
+        if (key_file.empty())
+            throw std::invalid_argument("Cannot read 3DES key: " + std::string(key_path));
+
+        return DES3Key::Parse(key_file.get_text());
     }
 
 private:
-    std::string EncryptBlock(const std::bitset<64>& block, const std::bitset<64>& key) {
-        std::bitset<block_bits_size_> cipher_text{Permutation(block, tbl::initial_permutation_table, 64)};
+    static constexpr DESCipher CipherOf(const DESKey&) noexcept { return DESCipher::kDES; }
 
-        std::vector<std::bitset<subkey_bits_size_>> round_keys{GenerateRoundKeys(key)};
+    static constexpr DESCipher CipherOf(const DES3Key&) noexcept { return DESCipher::k3DES; }
 
-        std::bitset<half_bits_size_> left_half(cipher_text.to_string().substr(0, half_bits_size_));
-        std::bitset<half_bits_size_> right_half(cipher_text.to_string().substr(half_bits_size_, half_bits_size_));
+    template <typename Key>
+    static DESHeader ReadHeader(std::string_view data, DESMode mode, const Key& key) {
+        DESHeader header{DESContainer::ReadHeader(data)};
+        CheckHeader(header, mode, key);
 
-        for (std::size_t i = 0; i < num_rounds_; ++i) {
-            std::bitset<half_bits_size_> new_right_half{left_half ^ Round(right_half, round_keys[i])};
-            left_half = right_half;
-            right_half = new_right_half;
-        }
+        return header;
+    }
 
-        std::bitset<block_bits_size_> encrypted_text{Permutation(cipher_text, tbl::final_permutation_table, 64)};
+    template <typename Key>
+    static void CheckHeader(const DESHeader& header, DESMode mode, const Key& key) {
+        if (header.mode != mode)
+            throw std::invalid_argument("DES container was written in another mode");
 
-        return encrypted_text.to_string();
+        if (header.cipher != CipherOf(key))
+            throw std::invalid_argument(header.cipher == DESCipher::k3DES ? "Container holds 3DES data, a 3DES key is required"
+                                                                           : "Container holds single DES data, a DES key is required");
     }
 
-    std::string DecryptBlock(const std::bitset<64>& block, const std::bitset<64>& key) {
-        std::bitset<block_bits_size_> decrypted_text{Permutation(block, tbl::initial_permutation_table, 64)};
+    static std::ifstream OpenInput(std::string_view file_path) {
+        std::ifstream in(fs::path(file_path), std::ios::binary | std::ios::in);
 
-        std::vector<std::bitset<subkey_bits_size_>> round_keys{GenerateRoundKeys(key)};
+        if (!in.is_open())
+            throw std::ios_base::failure("Cannot open file: " + std::string(file_path));
 
-        std::bitset<half_bits_size_> left_half(decrypted_text.to_string().substr(0, half_bits_size_));
-        std::bitset<half_bits_size_> right_half(decrypted_text.to_string().substr(half_bits_size_, half_bits_size_));
+        return in;
+    }
 
-        for (int i = 15; i >= 0; --i) {
-            std::bitset<half_bits_size_> new_right_half{left_half ^ Round(right_half, round_keys[i])};
-            left_half = right_half;
-            right_half = new_right_half;
-        }
+    static std::ofstream OpenOutput(const fs::path& file_path) {
+        std::ofstream out(file_path, std::ios::binary | std::ios::out | std::ios::trunc);
 
-        std::bitset<block_bits_size_> decrypted_plain_text{Permutation(decrypted_text, tbl::final_permutation_table, 64)};
+        if (!out.is_open())
+            throw std::ios_base::failure("Cannot create file: " + file_path.string());
 
-        std::string decrypted_string;
+        return out;
+    }
 
-        for (size_t i = 0; i < char_bits_size_; ++i) {
-            std::bitset<char_bits_size_> byte;
+    template <typename Key>
+    std::string EncryptECB(std::string_view text, const Key& key, DESPadding padding) {
+        if (padding == DESPadding::kNone)
+            throw std::invalid_argument("ECB needs kZero or kPKCS7 padding, kNone is for CTR only");
 
-            for (size_t j = 0; j < char_bits_size_; ++j)
-                byte[j] = decrypted_plain_text[i * char_bits_size_ + j];
+        DESHeader header;
+        header.mode = DESMode::kECB;
+        header.cipher = CipherOf(key);
+        header.padding = padding;
+        header.length = text.size();
 
-            if (!byte.none())
-                decrypted_string += static_cast<char>(byte.to_ulong());
-        }
+        std::string encrypted(DESContainer::header_size + DESContainer::PaddedSize(header.length, padding), '\0');
+        DESContainer::WriteHeader(header, encrypted.data());
 
-        return decrypted_string;
+        char* body{encrypted.data() + DESContainer::header_size};
+        std::size_t full_size{text.size() / DESCore::block_size * DESCore::block_size};
+
+        DESModes::CryptECB(text.data(), body, full_size / DESCore::block_size, key.EncryptSchedule(), threads_, backend_);
+
+        char tail[DESCore::block_size];
+        if (DESContainer::PadTail(text.data() + full_size, text.size() - full_size, padding, tail))
+            DESCore::Store(DESCore::Crypt(DESCore::Load(tail, DESCore::block_size), key.EncryptSchedule()), body + full_size);
+
+        return encrypted;
     }
 
-    std::bitset<64> Permutation(const std::bitset<64>& input, const int* table, int table_size) {
-        std::bitset<block_bits_size_> permuted_text;
+    template <typename Key>
+    std::string DecryptECB(std::string_view data, const Key& key) {
+        DESHeader header{ReadHeader(data, DESMode::kECB, key)};
+
+        std::string_view body{data.substr(DESContainer::header_size)};
+        std::string decrypted(body.size(), '\0');
+
+        DESModes::CryptECB(body.data(), decrypted.data(), body.size() / DESCore::block_size, key.DecryptSchedule(), threads_, backend_);
+
+        if (!decrypted.empty())
+            DESContainer::CheckPadding(decrypted.data() + decrypted.size() - DESCore::block_size, header);
+
+        decrypted.resize(header.length);
+
+        return decrypted;
+    }
+
+    template <typename Key>
+    std::string EncryptCTR(std::string_view text, const Key& key) {
+        DESHeader header;
+        header.mode = DESMode::kCTR;
+        header.cipher = CipherOf(key);
+        header.padding = DESPadding::kNone;
+        header.length = text.size();
+        header.iv = GenerateIV();
+
+        std::size_t body_offset{DESContainer::BodyOffset(header.mode)};
+        std::string encrypted(body_offset + text.size(), '\0');
+        DESContainer::WriteHeader(header, encrypted.data());
 
-        for (int i = 0; i < table_size; ++i)
-            permuted_text[i] = input[table[i] - 1];
+        DESModes::CryptCTR(text.data(), encrypted.data() + body_offset, text.size(), 0, header.iv, key.EncryptSchedule(), threads_, backend_);
 
-        return permuted_text;
+        return encrypted;
     }
 
-    std::bitset<32> Round(const std::bitset<32>& input, const std::bitset<48>& round_key) {
-        std::bitset<subkey_bits_size_> expanded_input;
+    template <typename Key>
+    std::string DecryptCTR(std::string_view data, const Key& key) {
+        DESHeader header{ReadHeader(data, DESMode::kCTR, key)};
 
-        for (std::size_t i = 0; i < subkey_bits_size_; ++i)
-            expanded_input[i] = input[tbl::expansion_table[i] - 1];
+        std::string_view body{data.substr(DESContainer::BodyOffset(header.mode))};
+        std::string decrypted(body.size(), '\0');
 
-        expanded_input ^= round_key;
-        
-        std::vector<std::bitset<miniblock_bits_size_>> input_blocks;
+        DESModes::CryptCTR(body.data(), decrypted.data(), body.size(), 0, header.iv, key.EncryptSchedule(), threads_, backend_);
 
-        for (std::size_t i = 0; i < subkey_bits_size_; i += miniblock_bits_size_)
-            input_blocks.push_back(expanded_input.to_ulong() >> (subkey_bits_size_ - (i + miniblock_bits_size_)));
-        
-        std::bitset<half_bits_size_> output;
-        for (std::size_t i = 0; i < char_bits_size_; ++i) {
-            int row = (input_blocks[i][0] << 1) + input_blocks[i][5];
-            int col = (input_blocks[i].to_ulong() >> 1) & 0x0F;
-            int val = tbl::s_box[i][row][col];
-            output |= (std::bitset<half_bits_size_>(val) << (key_half_bits_size_ - (i * 4)));
+        return decrypted;
+    }
+
+    /*
+        Container with the padded plaintext as body, ready to be encrypted
+        in place.
+    */
+    std::string PrepareCBC(std::string_view text, DESCipher cipher) {
+        DESHeader header;
+        header.mode = DESMode::kCBC;
+        header.cipher = cipher;
+        header.padding = DESPadding::kPKCS7;
+        header.length = text.size();
+        header.iv = GenerateIV();
+
+        std::size_t body_offset{DESContainer::BodyOffset(header.mode)};
+        std::string container(body_offset + DESContainer::PaddedSize(header.length, header.padding), '\0');
+        DESContainer::WriteHeader(header, container.data());
+
+        std::size_t full_size{text.size() / DESCore::block_size * DESCore::block_size};
+        std::copy(text.begin(), text.begin() + full_size, container.begin() + body_offset);
+        DESContainer::PadTail(text.data() + full_size, text.size() - full_size, header.padding, container.data() + body_offset + full_size);
+
+        return container;
+    }
+
+    /*
+        Encrypts containers made by PrepareCBC in place, as independent
+        interleaved streams.
+    */
+    template <typename Key>
+    void EncryptCBC(std::vector<std::string>& containers, const Key& key) {
+        std::vector<DESModes::CBCLane> lanes;
+        lanes.reserve(containers.size());
+
+        for (auto& container : containers) {
+            DESHeader header{DESContainer::ReadHeader(container)};
+            std::size_t body_offset{DESContainer::BodyOffset(header.mode)};
+
+            lanes.push_back({container.data() + body_offset, (container.size() - body_offset) / DESCore::block_size, header.iv});
         }
-        
-        std::bitset<half_bits_size_> permuted_output;
 
-        for (std::size_t i = 0; i < half_bits_size_; ++i)
-            permuted_output[i] = output[tbl::permutation_table[i] - 1];
-        
-        return permuted_output;
+        DESModes::EncryptCBC(lanes, key.EncryptSchedule(), threads_);
     }
 
-    std::vector<std::bitset<48>> GenerateRoundKeys(const std::bitset<64>& main_key) {
-        std::vector<std::bitset<subkey_bits_size_>> round_keys(num_rounds_);
-        std::bitset<round_key_bits_size_> key_permuted;
+    template <typename Key>
+    std::string DecryptCBC(std::string_view data, const Key& key) {
+        DESHeader header{ReadHeader(data, DESMode::kCBC, key)};
+
+        std::string_view body{data.substr(DESContainer::BodyOffset(header.mode))};
+        std::string decrypted(body.size(), '\0');
 
-        for (std::size_t i = 0; i < round_key_bits_size_; ++i)
-            key_permuted[i] = main_key[tbl::key_permutation_table[i] - 1];
+        DESModes::DecryptCBC(body.data(), decrypted.data(), body.size() / DESCore::block_size, header.iv, key.DecryptSchedule(), threads_, backend_);
 
-        std::bitset<key_half_bits_size_> left_key_half, right_key_half;
+        if (!decrypted.empty())
+            DESContainer::CheckPadding(decrypted.data() + decrypted.size() - DESCore::block_size, header);
 
-        for (std::size_t i = 0; i < key_half_bits_size_; ++i) {
-            left_key_half[i] = key_permuted[i];
-            right_key_half[i] = key_permuted[i + key_half_bits_size_];
+        decrypted.resize(header.length);
+
+        return decrypted;
+    }
+
+    static uint64_t GenerateIV() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) | device();
+    }
+
+private:
+    template <typename Key>
+    std::string EncryptTextECB(std::string_view text, const Key& key) {
+        std::vector<std::string> encrypted_blocks;
+
+        for (std::size_t i{}; i < text.size(); i += char_bits_size_) {
+            uint64_t block{DESCore::Load(text.data() + i, text.size() - i)};
+
+            encrypted_blocks.push_back(EncryptBlock(block, key));
         }
 
-        for (std::size_t i = 0; i < num_rounds_; ++i) {
-            left_key_half = (left_key_half << tbl::key_shift_table[i]) | (left_key_half >> (key_half_bits_size_ - tbl::key_shift_table[i]));
-            right_key_half = (right_key_half << tbl::key_shift_table[i]) | (right_key_half >> (key_half_bits_size_ - tbl::key_shift_table[i]));
-            
-            std::bitset<round_key_bits_size_> combined_key_half;
-
-            for (std::size_t j = 0; j < key_half_bits_size_; ++j) {
-                combined_key_half[j] = left_key_half[j];
-                combined_key_half[j + key_half_bits_size_] = right_key_half[j];
-            }
-            
-            std::bitset<subkey_bits_size_> compressed_key;
-
-            for (std::size_t j = 0; j < subkey_bits_size_; ++j)
-                compressed_key[j] = combined_key_half[tbl::key_compression_table[j] - 1];
-            
-            round_keys[i] = compressed_key;
+        return std::accumulate(encrypted_blocks.begin(), encrypted_blocks.end(), std::string(""));
+    }
+
+    template <typename Key>
+    std::string DecryptTextECB(std::string_view text, const Key& key) {
+        std::vector<std::string> decrypted_blocks;
+
+        for (std::size_t i{}; i < text.size(); i += block_bits_size_) {
+            std::string block_str(text.substr(i, block_bits_size_));
+            std::bitset<block_bits_size_> block_bits(block_str);
+
+            decrypted_blocks.push_back(DecryptBlock(block_bits.to_ullong(), key));
         }
 
-        return round_keys;
+        return std::accumulate(decrypted_blocks.begin(), decrypted_blocks.end(), std::string(""));
+    }
+
+    template <typename Key>
+    std::string EncryptBlock(uint64_t block, const Key& key) {
+        uint64_t encrypted{DESCore::Crypt(block, key.EncryptSchedule())};
+
+        return std::bitset<block_bits_size_>(encrypted).to_string();
+    }
+
+    template <typename Key>
+    std::string DecryptBlock(uint64_t block, const Key& key) {
+        uint64_t decrypted{DESCore::Crypt(block, key.DecryptSchedule())};
+
+        char bytes[DESCore::block_size];
+        DESCore::Store(decrypted, bytes);
+
+        std::string decrypted_string;
+
+        for (char byte : bytes)
+            if (byte != '\0')
+                decrypted_string += byte;
+
+        return decrypted_string;
     }
 
 private:
@@ -202,21 +537,18 @@ private:
             filename.insert(pos, postfix);
         else
             filename += postfix;
-        
+
         return fs::path(filename);
     }
 
 private:
-    static constexpr const std::size_t num_rounds_{16};
     static constexpr const std::size_t char_bits_size_{8};
-    static constexpr const std::size_t key_bits_size_{64};
-    static constexpr const std::size_t half_bits_size_{32};
     static constexpr const std::size_t block_bits_size_{64};
-    static constexpr const std::size_t subkey_bits_size_{48};
-    static constexpr const std::size_t miniblock_bits_size_{6};
-    static constexpr const std::size_t key_half_bits_size_{28};
-    static constexpr const std::size_t round_key_bits_size_{56};
 
+    std::size_t threads_{Parallel::DefaultThreads()};
+    DESBackend backend_{DESBackend::kAuto};
+    std::size_t stream_window_{DESStream::default_window};
+    DESKeyCache key_cache_;
     tools::filesystem::monitoring fsm_;
 };
 } // namespace s21
@@ -0,0 +1,234 @@
+#ifndef CRYPTO_MODEL_DES_FAST_TABLES_HPP
+#define CRYPTO_MODEL_DES_FAST_TABLES_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "tables.hpp"
+
+/*
+    Lookup tables for the integer block core, generated at compile time from
+    the FIPS 46-3 tables in tables.hpp, which number bits 1..n from the most
+    significant end. Blocks and keys are uint64_t values with standard bit p
+    at bit 64 - p (first byte in the top byte). Inside the rounds the core
+    uses its own layout, chosen so that the expansion is a rotation and each
+    S-box output is a nibble:
+        - a half block keeps standard bit q at bit q - 1;
+        - the permuted block holds R0 in bits 0..31 and L0 in bits 32..63;
+        - S-box b writes its output (most significant bit = standard bit
+          4b + 1) to bits 28 - 4b .. 31 - 4b before P.
+    The internal_* tables below are the standard permutations renumbered
+    to that layout, in the same "1-based source bit" form that permute_bits
+    and the bitsliced engine consume.
+*/
+namespace tbl {
+namespace gen {
+using permutation_lookup_t = std::array<std::array<uint64_t, 256>, 8>;
+using sp_lookup_t          = std::array<std::array<uint32_t, 64>, 8>;
+using shift_lookup_t       = std::array<unsigned, 8>;
+using index_table_t        = std::array<int, 64>;
+using inverse_lookup_t     = std::array<uint8_t, 32>;
+
+/*
+    Bit i of the result is bit table[i] - 1 of the input (both counted from
+    the least significant end).
+*/
+constexpr uint64_t permute_bits(uint64_t input, const int* table, std::size_t table_size) noexcept {
+    uint64_t result{};
+
+    for (std::size_t i{}; i < table_size; ++i)
+        result |= ((input >> (table[i] - 1)) & 1) << i;
+
+    return result;
+}
+
+/*
+    A FIPS 46-3 permutation as written in the standard: output bit i + 1
+    is input bit table[i], bits counted from the most significant end of
+    an input_size / table_size bit value.
+*/
+constexpr uint64_t permute_standard(uint64_t input, const int* table, std::size_t table_size, std::size_t input_size) noexcept {
+    uint64_t result{};
+
+    for (std::size_t i{}; i < table_size; ++i)
+        result = (result << 1) | ((input >> (input_size - table[i])) & 1);
+
+    return result;
+}
+
+/*
+    IP into the core layout: R0 (standard bits 33..64 of IP's output) in
+    bits 0..31, L0 (bits 1..32) in bits 32..63.
+*/
+constexpr index_table_t make_internal_initial_permutation() noexcept {
+    index_table_t result{};
+
+    for (std::size_t q{}; q < 32; ++q) {
+        result[q] = 65 - initial_permutation_table[32 + q];
+        result[32 + q] = 65 - initial_permutation_table[q];
+    }
+
+    return result;
+}
+
+/*
+    FP from the core layout: the core hands over L16 in bits 0..31 and R16
+    in bits 32..63, while FP's input is R16 L16 in standard order.
+*/
+constexpr index_table_t make_internal_final_permutation() noexcept {
+    index_table_t result{};
+
+    for (std::size_t p{1}; p <= 64; ++p) {
+        int source{final_permutation_table[p - 1]};
+        result[64 - p] = source <= 32 ? 32 + source : source - 32;
+    }
+
+    return result;
+}
+
+/*
+    P between the S-box nibbles and the half block: standard S-box output
+    bit s sits in bit 32 - s.
+*/
+constexpr std::array<int, 32> make_internal_permutation() noexcept {
+    std::array<int, 32> result{};
+
+    for (std::size_t q{}; q < 32; ++q)
+        result[q] = 33 - permutation_table[q];
+
+    return result;
+}
+
+static constexpr const index_table_t internal_initial_permutation{make_internal_initial_permutation()};
+static constexpr const index_table_t internal_final_permutation{make_internal_final_permutation()};
+static constexpr const std::array<int, 32> internal_permutation{make_internal_permutation()};
+
+/*
+    Row from group bits 0 and 5 (standard bits 1 and 6), column from bits
+    1..4 with bit 1 (standard bit 2) most significant.
+*/
+constexpr int sbox_value(std::size_t b, std::size_t group) noexcept {
+    std::size_t row{((group & 1) << 1) | ((group >> 5) & 1)};
+    std::size_t col{((group >> 1) & 1) << 3 | ((group >> 2) & 1) << 2 | ((group >> 3) & 1) << 1 | ((group >> 4) & 1)};
+
+    return s_box[b][row][col];
+}
+
+/*
+    A 64-bit permutation split into eight byte-indexed tables:
+    permute(x) == OR of table[i][byte i of x].
+*/
+constexpr permutation_lookup_t make_permutation_lookup(const int* table) noexcept {
+    permutation_lookup_t result{};
+
+    for (std::size_t i{}; i < 64; ++i) {
+        std::size_t source{static_cast<std::size_t>(table[i] - 1)};
+
+        for (std::size_t value{}; value < 256; ++value)
+            if ((value >> (source % 8)) & 1)
+                result[source / 8][value] |= uint64_t{1} << i;
+    }
+
+    return result;
+}
+
+/*
+    S-box b followed by the P permutation, indexed by the 6-bit group
+    (bit j of the group is standard bit 6b + j + 1 of the expanded half).
+*/
+constexpr sp_lookup_t make_sp_lookup() noexcept {
+    sp_lookup_t result{};
+
+    for (std::size_t b{}; b < 8; ++b) {
+        for (std::size_t group{}; group < 64; ++group) {
+            uint64_t value{static_cast<uint64_t>(sbox_value(b, group))};
+
+            result[b][group] = static_cast<uint32_t>(permute_bits(value << (28 - b * 4), internal_permutation.data(), 32));
+        }
+    }
+
+    return result;
+}
+
+/*
+    The expansion takes each S-box group from six cyclically consecutive bits
+    of the half block, so E reduces to a rotation and a 6-bit mask per group.
+*/
+constexpr shift_lookup_t make_expansion_shifts() noexcept {
+    shift_lookup_t result{};
+
+    for (std::size_t b{}; b < 8; ++b)
+        result[b] = static_cast<unsigned>(expansion_table[b * 6] - 1);
+
+    return result;
+}
+
+constexpr bool is_expansion_rotational() noexcept {
+    for (std::size_t b{}; b < 8; ++b) {
+        unsigned shift{static_cast<unsigned>(expansion_table[b * 6] - 1)};
+
+        for (std::size_t j{}; j < 6; ++j)
+            if (static_cast<unsigned>(expansion_table[b * 6 + j] - 1) != (shift + j) % 32)
+                return false;
+    }
+
+    return true;
+}
+
+/*
+    Inverse of the P permutation: output bit o of the S-box layer ends up
+    in bit inverse[o] of the round function result.
+*/
+constexpr inverse_lookup_t make_permutation_inverse() noexcept {
+    inverse_lookup_t result{};
+
+    for (std::size_t i{}; i < 32; ++i)
+        result[static_cast<std::size_t>(internal_permutation[i] - 1)] = static_cast<uint8_t>(i);
+
+    return result;
+}
+
+/*
+    Boolean form of the S-boxes for the bitsliced engine. For S-box b,
+    output bit t and row-bit pair c (group bits 4 and 5), index[b][t][c]
+    lists the values m of group bits 0..3 for which the output bit is set,
+    so out_t = XOR_c (decode(bits 4, 5) == c) & XOR_m (decode(bits 0..3) == m).
+*/
+struct sbox_terms_t {
+    std::array<std::array<std::array<uint8_t, 4>, 4>, 8> count{};
+    std::array<std::array<std::array<std::array<uint8_t, 16>, 4>, 4>, 8> index{};
+};
+
+constexpr sbox_terms_t make_sbox_terms() noexcept {
+    sbox_terms_t result{};
+
+    for (std::size_t b{}; b < 8; ++b) {
+        for (std::size_t group{}; group < 64; ++group) {
+            int value{sbox_value(b, group)};
+
+            for (std::size_t t{}; t < 4; ++t) {
+                if ((value >> t) & 1) {
+                    std::size_t c{group >> 4};
+                    auto& count{result.count[b][t][c]};
+                    result.index[b][t][c][count++] = static_cast<uint8_t>(group & 0x0F);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+static_assert(is_expansion_rotational(), "Expansion table groups must be cyclically consecutive bits");
+
+static constexpr const permutation_lookup_t initial_permutation_lookup{make_permutation_lookup(internal_initial_permutation.data())};
+static constexpr const permutation_lookup_t final_permutation_lookup{make_permutation_lookup(internal_final_permutation.data())};
+static constexpr const sp_lookup_t sp_lookup{make_sp_lookup()};
+static constexpr const shift_lookup_t expansion_shifts{make_expansion_shifts()};
+static constexpr const inverse_lookup_t permutation_inverse{make_permutation_inverse()};
+static constexpr const sbox_terms_t sbox_terms{make_sbox_terms()};
+} // namespace gen
+} // namespace tbl
+
+#endif // CRYPTO_MODEL_DES_FAST_TABLES_HPP
@@ -0,0 +1,203 @@
+#ifndef CRYPTO_MODEL_DES_KEY_HPP
+#define CRYPTO_MODEL_DES_KEY_HPP
+
+#include <list>
+#include <mutex>
+#include <bitset>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "core.hpp"
+
+namespace s21 {
+/*
+    A DES key with both round-key schedules expanded once.
+*/
+class DESKey {
+public:
+    using schedule_type = DESCore::schedule_type;
+
+public:
+    explicit DESKey(uint64_t key) :
+        key_(key),
+        encrypt_schedule_(DESCore::GenerateSchedule(key)),
+        decrypt_schedule_(DESCore::ReverseSchedule(encrypt_schedule_))
+    {}
+
+    ~DESKey() = default;
+
+public:
+    /*
+        Key files store the 64 key bits as '0'/'1' text, most significant first.
+    */
+    static uint64_t Parse(std::string_view text) {
+        return std::bitset<key_bits_size_>(text.data(), text.size()).to_ullong();
+    }
+
+public:
+    uint64_t Value() const noexcept { return key_; }
+
+    const schedule_type& EncryptSchedule() const noexcept { return encrypt_schedule_; }
+
+    const schedule_type& DecryptSchedule() const noexcept { return decrypt_schedule_; }
+
+private:
+    static constexpr const std::size_t key_bits_size_{64};
+
+    uint64_t key_{};
+    schedule_type encrypt_schedule_{};
+    schedule_type decrypt_schedule_{};
+};
+
+/*
+    A 3DES EDE key (k1, k2, k3). The three schedules are fused into one
+    48-round schedule, E_k1 | D_k2 | E_k3, so a block passes through the
+    cipher once with a single IP and FP; decryption is the whole schedule
+    reversed. Keys and blocks use the FIPS 46-3 ordering of DESCore, so
+    the result is standard TDEA (checked against the NIST SP 800-67
+    example).
+*/
+class DES3Key {
+public:
+    using schedule_type = DESCore::triple_schedule_type;
+
+public:
+    DES3Key(uint64_t k1, uint64_t k2, uint64_t k3) :
+        keys_{k1, k2, k3},
+        encrypt_schedule_(Fuse(k1, k2, k3)),
+        decrypt_schedule_(DESCore::ReverseSchedule(encrypt_schedule_))
+    {}
+
+    ~DES3Key() = default;
+
+public:
+    /*
+        Key files hold 64, 128 or 192 '0'/'1' characters (line breaks are
+        ignored): one key gives k1 = k2 = k3 (plain DES), two keys k3 = k1.
+    */
+    static DES3Key Parse(std::string_view text) {
+        std::string bits;
+
+        for (char c : text)
+            if (c == '0' || c == '1')
+                bits.push_back(c);
+            else if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                throw std::invalid_argument("3DES key must consist of '0' and '1' characters");
+
+        if (bits.size() != key_bits_size_ && bits.size() != 2 * key_bits_size_ && bits.size() != 3 * key_bits_size_)
+            throw std::invalid_argument("3DES key must be 64, 128 or 192 bits long");
+
+        std::string_view view{bits};
+        uint64_t k1{DESKey::Parse(view.substr(0, key_bits_size_))};
+        uint64_t k2{bits.size() > key_bits_size_ ? DESKey::Parse(view.substr(key_bits_size_, key_bits_size_)) : k1};
+        uint64_t k3{bits.size() > 2 * key_bits_size_ ? DESKey::Parse(view.substr(2 * key_bits_size_)) : k1};
+
+        return DES3Key(k1, k2, k3);
+    }
+
+public:
+    uint64_t Value(std::size_t index) const noexcept { return keys_[index]; }
+
+    const schedule_type& EncryptSchedule() const noexcept { return encrypt_schedule_; }
+
+    const schedule_type& DecryptSchedule() const noexcept { return decrypt_schedule_; }
+
+private:
+    static schedule_type Fuse(uint64_t k1, uint64_t k2, uint64_t k3) noexcept {
+        DESCore::schedule_type first{DESCore::GenerateSchedule(k1)};
+        DESCore::schedule_type second{DESCore::ReverseSchedule(DESCore::GenerateSchedule(k2))};
+        DESCore::schedule_type third{DESCore::GenerateSchedule(k3)};
+
+        schedule_type fused{};
+        for (std::size_t i{}; i < DESCore::num_rounds; ++i) {
+            fused[i] = first[i];
+            fused[DESCore::num_rounds + i] = second[i];
+            fused[2 * DESCore::num_rounds + i] = third[i];
+        }
+
+        return fused;
+    }
+
+private:
+    static constexpr const std::size_t key_bits_size_{64};
+
+    std::array<uint64_t, 3> keys_{};
+    schedule_type encrypt_schedule_{};
+    schedule_type decrypt_schedule_{};
+};
+
+/*
+    Bounded LRU cache of expanded keys, keyed by the key value, so a batch
+    job reusing one key never expands it twice.
+*/
+class DESKeyCache {
+public:
+    using key_pointer = std::shared_ptr<const DESKey>;
+    using size_type   = std::size_t;
+
+public:
+    DESKeyCache() : DESKeyCache(default_capacity_) {}
+
+    explicit DESKeyCache(size_type capacity) :
+        capacity_(capacity ? capacity : 1)
+    {}
+
+    ~DESKeyCache() = default;
+
+public:
+    key_pointer Get(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it{index_.find(key)};
+        if (it != index_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->second;
+        }
+
+        if (entries_.size() == capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+
+        entries_.emplace_front(key, std::make_shared<const DESKey>(key));
+        index_[key] = entries_.begin();
+
+        return entries_.front().second;
+    }
+
+    key_pointer Get(std::string_view text) {
+        return Get(DESKey::Parse(text));
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        index_.clear();
+        entries_.clear();
+    }
+
+public:
+    size_type size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    size_type capacity() const noexcept { return capacity_; }
+
+private:
+    using entry_list = std::list<std::pair<uint64_t, key_pointer>>;
+
+    static constexpr const size_type default_capacity_{16};
+
+    size_type capacity_{};
+    entry_list entries_;
+    std::unordered_map<uint64_t, entry_list::iterator> index_;
+    mutable std::mutex mutex_;
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_KEY_HPP
@@ -0,0 +1,221 @@
+#ifndef CRYPTO_MODEL_DES_MODES_HPP
+#define CRYPTO_MODEL_DES_MODES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "core.hpp"
+#include "bitslice.hpp"
+#include "parallel.hpp"
+
+namespace s21 {
+/*
+    Block-cipher modes over raw buffers, for both DES and 3DES schedules
+    (DESCore::schedule_type / triple_schedule_type). Parallel modes split
+    the input into block-aligned chunks that worker threads process
+    straight into the caller's preallocated output; CBC encryption
+    parallelizes across independent streams instead.
+*/
+class DESModes {
+public:
+    using size_type     = std::size_t;
+    using schedule_type = DESCore::schedule_type;
+
+    /*
+        One independent CBC stream, encrypted in place.
+    */
+    struct CBCLane {
+        char* data{nullptr};
+        size_type num_blocks{};
+        uint64_t iv{};
+    };
+
+public:
+    /*
+        Minimum number of blocks (64 KiB) worth handing to another thread.
+    */
+    static constexpr const size_type grain_blocks{8192};
+
+    /*
+        Number of CBC streams a thread keeps in flight at once.
+    */
+    static constexpr const size_type cbc_lanes{4};
+
+public:
+    /*
+        Encrypts or decrypts (depending on the schedule) `num_blocks` whole
+        blocks; `in` and `out` may alias.
+    */
+    template <typename Schedule>
+    static void CryptECB(const char* in, char* out, size_type num_blocks, const Schedule& schedule,
+                         size_type threads, DESBackend backend = DESBackend::kScalar) {
+        backend = DESBitslice::Resolve(backend);
+
+        Parallel::For(0, num_blocks, grain_blocks, threads, [&](size_type begin, size_type end) {
+            CryptBatches(begin, end, schedule, backend,
+                [&](size_type i) {
+                    return DESCore::Load(in + i * DESCore::block_size, DESCore::block_size);
+                },
+                [&](size_type i, uint64_t block) {
+                    DESCore::Store(block, out + i * DESCore::block_size);
+                });
+        });
+    }
+
+    /*
+        Counter mode: byte p of the stream is XORed with byte p % 8 of
+        E(iv + p / 8). `offset` is the stream position of in[0], so any
+        range of a file can be processed on its own; `in` and `out` may
+        alias. Encryption and decryption are the same operation and both
+        use the encryption schedule.
+    */
+    template <typename Schedule>
+    static void CryptCTR(const char* in, char* out, size_type size, uint64_t offset, uint64_t iv,
+                         const Schedule& schedule, size_type threads, DESBackend backend = DESBackend::kScalar) {
+        if (!size)
+            return;
+
+        backend = DESBitslice::Resolve(backend);
+
+        uint64_t first_block{offset / DESCore::block_size};
+        uint64_t last_block{(offset + size - 1) / DESCore::block_size};
+        uint64_t end_offset{offset + size};
+
+        Parallel::For(0, last_block - first_block + 1, grain_blocks, threads, [&](size_type begin, size_type end) {
+            CryptBatches(begin, end, schedule, backend,
+                [&](size_type i) {
+                    return iv + first_block + i;
+                },
+                [&](size_type i, uint64_t keystream) {
+                    uint64_t block_begin{(first_block + i) * DESCore::block_size};
+                    uint64_t lo{std::max(block_begin, offset)};
+                    uint64_t hi{std::min(block_begin + DESCore::block_size, end_offset)};
+
+                    if (hi - lo == DESCore::block_size) {
+                        size_type pos{lo - offset};
+                        DESCore::Store(DESCore::Load(in + pos, DESCore::block_size) ^ keystream, out + pos);
+                        return;
+                    }
+
+                    for (uint64_t p{lo}; p < hi; ++p) {
+                        unsigned shift{static_cast<unsigned>(56 - (p - block_begin) * 8)};
+                        out[p - offset] = static_cast<char>(in[p - offset] ^ static_cast<char>((keystream >> shift) & 0xFF));
+                    }
+                });
+        });
+    }
+
+    /*
+        CBC decryption: P[i] = D(C[i]) ^ C[i - 1] only depends on the
+        ciphertext, so it splits into chunks like ECB. `in` and `out` must
+        not alias.
+    */
+    template <typename Schedule>
+    static void DecryptCBC(const char* in, char* out, size_type num_blocks, uint64_t iv,
+                           const Schedule& schedule, size_type threads, DESBackend backend = DESBackend::kScalar) {
+        backend = DESBitslice::Resolve(backend);
+
+        Parallel::For(0, num_blocks, grain_blocks, threads, [&](size_type begin, size_type end) {
+            CryptBatches(begin, end, schedule, backend,
+                [&](size_type i) {
+                    return DESCore::Load(in + i * DESCore::block_size, DESCore::block_size);
+                },
+                [&](size_type i, uint64_t block) {
+                    uint64_t previous{i ? DESCore::Load(in + (i - 1) * DESCore::block_size, DESCore::block_size) : iv};
+                    DESCore::Store(block ^ previous, out + i * DESCore::block_size);
+                });
+        });
+    }
+
+    /*
+        CBC encryption of one stream is inherently serial, so throughput
+        comes from running several independent streams side by side: each
+        thread keeps `cbc_lanes` streams in flight and advances them one
+        block per pass, letting their dependency chains overlap. A finished
+        lane's slot is refilled with the next pending stream.
+    */
+    template <typename Schedule>
+    static void EncryptCBC(std::vector<CBCLane>& lanes, const Schedule& schedule, size_type threads) {
+        Parallel::For(0, lanes.size(), 1, threads, [&](size_type begin, size_type end) {
+            struct Slot {
+                CBCLane* lane{nullptr};
+                size_type position{};
+                uint64_t previous{};
+            };
+
+            Slot slots[cbc_lanes];
+            size_type next{begin};
+            size_type active{};
+
+            auto refill{[&](Slot& slot) {
+                slot.lane = nullptr;
+
+                while (next < end && !slot.lane) {
+                    CBCLane& lane{lanes[next++]};
+
+                    if (lane.num_blocks)
+                        slot = Slot{&lane, 0, lane.iv};
+                }
+
+                if (slot.lane)
+                    ++active;
+            }};
+
+            for (auto& slot : slots)
+                refill(slot);
+
+            while (active) {
+                for (auto& slot : slots) {
+                    if (!slot.lane)
+                        continue;
+
+                    char* block_data{slot.lane->data + slot.position * DESCore::block_size};
+                    slot.previous = DESCore::Crypt(DESCore::Load(block_data, DESCore::block_size) ^ slot.previous, schedule);
+                    DESCore::Store(slot.previous, block_data);
+
+                    if (++slot.position == slot.lane->num_blocks) {
+                        --active;
+                        refill(slot);
+                    }
+                }
+            }
+        });
+    }
+
+private:
+    /*
+        Runs blocks [begin, end) through the block cipher: fill(i) produces
+        the input of block i, consume(i, result) takes its output. The
+        bitsliced backends work on batches of 64/256 blocks.
+    */
+    template <typename Schedule, typename Fill, typename Consume>
+    static void CryptBatches(size_type begin, size_type end, const Schedule& schedule, DESBackend backend,
+                             Fill&& fill, Consume&& consume) {
+        if (backend == DESBackend::kScalar) {
+            for (size_type i{begin}; i < end; ++i)
+                consume(i, DESCore::Crypt(fill(i), schedule));
+
+            return;
+        }
+
+        uint64_t batch[DESBitslice::batch_256];
+        size_type batch_size{DESBitslice::BatchSize(backend)};
+
+        for (size_type i{begin}; i < end; i += batch_size) {
+            size_type count{std::min(batch_size, end - i)};
+
+            for (size_type k{}; k < count; ++k)
+                batch[k] = fill(i + k);
+
+            DESBitslice::Crypt(backend, batch, count, schedule);
+
+            for (size_type k{}; k < count; ++k)
+                consume(i + k, batch[k]);
+        }
+    }
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_MODES_HPP
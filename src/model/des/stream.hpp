@@ -0,0 +1,157 @@
+#ifndef CRYPTO_MODEL_DES_STREAM_HPP
+#define CRYPTO_MODEL_DES_STREAM_HPP
+
+#include <ios>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+
+#include "core.hpp"
+#include "modes.hpp"
+#include "bitslice.hpp"
+#include "container.hpp"
+
+namespace s21 {
+/*
+    Constant-memory DES over streams: the input is read in windows of a
+    fixed size, each window is run through DESModes in place and written
+    out, so memory stays at two windows whatever the file size. The
+    output is the same DESContainer the in-memory path produces, and the
+    two can decode each other's files.
+*/
+class DESStream {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type default_window{4 << 20};
+
+public:
+    explicit DESStream(size_type window = default_window, size_type threads = 1, DESBackend backend = DESBackend::kScalar) :
+        window_(std::max(window / DESCore::block_size * DESCore::block_size, DESCore::block_size)),
+        threads_(threads ? threads : 1),
+        backend_(backend)
+    {}
+
+    ~DESStream() = default;
+
+public:
+    /*
+        Writes the header and then the encrypted body of `header.length`
+        bytes read from `in`. CTR takes the encryption schedule like every
+        other mode here.
+    */
+    template <typename Schedule>
+    void Encrypt(std::istream& in, std::ostream& out, const DESHeader& header, const Schedule& schedule) const {
+        char header_data[DESContainer::header_size + DESContainer::iv_size]{};
+        DESContainer::WriteHeader(header, header_data);
+        Write(out, header_data, DESContainer::BodyOffset(header.mode));
+
+        std::vector<char> buffer(window_ + DESCore::block_size);
+        uint64_t position{};
+        uint64_t chain{header.iv};
+
+        for (bool is_last{}; !is_last;) {
+            size_type size{static_cast<size_type>(std::min<uint64_t>(window_, header.length - position))};
+            is_last = position + size == header.length;
+
+            Read(in, buffer.data(), size);
+
+            size_type body_size{size};
+            if (header.mode != DESMode::kCTR) {
+                body_size = size / DESCore::block_size * DESCore::block_size;
+
+                char tail[DESCore::block_size];
+                if (is_last && DESContainer::PadTail(buffer.data() + body_size, size - body_size, header.padding, tail)) {
+                    std::copy(tail, tail + DESCore::block_size, buffer.data() + body_size);
+                    body_size += DESCore::block_size;
+                }
+            }
+
+            size_type num_blocks{body_size / DESCore::block_size};
+
+            if (header.mode == DESMode::kECB) {
+                DESModes::CryptECB(buffer.data(), buffer.data(), num_blocks, schedule, threads_, backend_);
+            } else if (header.mode == DESMode::kCBC) {
+                std::vector<DESModes::CBCLane> lanes{{buffer.data(), num_blocks, chain}};
+                DESModes::EncryptCBC(lanes, schedule, 1);
+
+                if (num_blocks)
+                    chain = DESCore::Load(buffer.data() + body_size - DESCore::block_size, DESCore::block_size);
+            } else {
+                DESModes::CryptCTR(buffer.data(), buffer.data(), size, position, header.iv, schedule, threads_, backend_);
+            }
+
+            Write(out, buffer.data(), body_size);
+            position += size;
+        }
+    }
+
+    /*
+        Reads the body that follows an already parsed header and writes
+        the `header.length` plaintext bytes. Pass the decryption schedule,
+        or the encryption schedule for CTR.
+    */
+    template <typename Schedule>
+    void Decrypt(std::istream& in, std::ostream& out, const DESHeader& header, const Schedule& schedule) const {
+        std::vector<char> input(window_), output(window_);
+        uint64_t body_size{DESContainer::PaddedSize(header.length, header.padding)};
+        uint64_t position{};
+        uint64_t chain{header.iv};
+
+        for (bool is_last{}; !is_last;) {
+            size_type size{static_cast<size_type>(std::min<uint64_t>(window_, body_size - position))};
+            is_last = position + size == body_size;
+
+            Read(in, input.data(), size);
+
+            size_type num_blocks{size / DESCore::block_size};
+
+            if (header.mode == DESMode::kECB) {
+                DESModes::CryptECB(input.data(), output.data(), num_blocks, schedule, threads_, backend_);
+            } else if (header.mode == DESMode::kCBC) {
+                DESModes::DecryptCBC(input.data(), output.data(), num_blocks, chain, schedule, threads_, backend_);
+
+                if (num_blocks)
+                    chain = DESCore::Load(input.data() + size - DESCore::block_size, DESCore::block_size);
+            } else {
+                DESModes::CryptCTR(input.data(), output.data(), size, position, header.iv, schedule, threads_, backend_);
+            }
+
+            if (is_last && header.mode != DESMode::kCTR && size)
+                DESContainer::CheckPadding(output.data() + size - DESCore::block_size, header);
+
+            if (position < header.length)
+                Write(out, output.data(), static_cast<size_type>(std::min<uint64_t>(size, header.length - position)));
+
+            position += size;
+        }
+    }
+
+public:
+    size_type Window() const noexcept { return window_; }
+
+private:
+    static void Read(std::istream& in, char* data, size_type size) {
+        in.read(data, static_cast<std::streamsize>(size));
+
+        if (static_cast<size_type>(in.gcount()) != size)
+            throw std::ios_base::failure("Unexpected end of DES stream");
+    }
+
+    static void Write(std::ostream& out, const char* data, size_type size) {
+        if (!out.write(data, static_cast<std::streamsize>(size)))
+            throw std::ios_base::failure("Cannot write DES stream");
+    }
+
+private:
+    size_type window_{};
+    size_type threads_{};
+    DESBackend backend_{};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_DES_STREAM_HPP
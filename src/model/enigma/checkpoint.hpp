@@ -0,0 +1,66 @@
+#ifndef CRYPTO_MODEL_ENIGMA_CHECKPOINT_HPP
+#define CRYPTO_MODEL_ENIGMA_CHECKPOINT_HPP
+
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+
+#include "tools.hpp"
+
+namespace s21 {
+/*
+    Progress of a resumable Enigma run, kept next to the output as
+    "<output>.ckpt". The machine state at any byte only depends on the
+    number of steps before it, so the committed input offset and the step
+    position (mod 128) are all a restart needs. The config hash and input
+    size guard against resuming with other rotors or a changed file.
+*/
+struct EnigmaCheckpoint {
+    uint64_t config_hash{};
+    uint64_t input_size{};
+    uint64_t offset{};
+    uint64_t position{};
+
+    static fs::path PathFor(const fs::path& output) {
+        return fs::path(output.string() + ".ckpt");
+    }
+
+    /*
+        Empty if there is no checkpoint or it cannot be parsed.
+    */
+    static std::optional<EnigmaCheckpoint> Load(const fs::path& path) {
+        std::ifstream file(path, std::ios::in);
+        std::string magic;
+        EnigmaCheckpoint checkpoint;
+
+        if (!(file >> magic >> checkpoint.config_hash >> checkpoint.input_size >> checkpoint.offset >> checkpoint.position) ||
+            magic != magic_ || checkpoint.offset > checkpoint.input_size)
+            return std::nullopt;
+
+        return checkpoint;
+    }
+
+    /*
+        Written to a temporary file and renamed over the old one, so a crash
+        leaves either the previous checkpoint or the new one.
+    */
+    void Save(const fs::path& path) const {
+        fs::path tmp_path(path.string() + ".tmp");
+
+        {
+            std::ofstream file(tmp_path, std::ios::out | std::ios::trunc);
+
+            if (!(file << magic_ << ' ' << config_hash << ' ' << input_size << ' ' << offset << ' ' << position << '\n') || !file.flush())
+                throw std::ios_base::failure("Error: Cannot write checkpoint: " + tmp_path.filename().generic_string());
+        }
+
+        fs::rename(tmp_path, path);
+    }
+
+private:
+    static constexpr const char* magic_{"S21C1"};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_ENIGMA_CHECKPOINT_HPP
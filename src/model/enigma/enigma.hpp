@@ -3,14 +3,19 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <memory>
 #include <fstream>
+#include <algorithm>
 #include <sstream>
 #include <string_view>
 
 #include "tools.hpp"
 
 #include "rotor.hpp"
+#include "keystream.hpp"
+#include "checkpoint.hpp"
+#include "parallel.hpp"
 #include "reflector.hpp"
 
 namespace s21 {
@@ -24,53 +29,145 @@ private:
 public:
     Enigma() : Enigma(1) {}
 
-    explicit Enigma(int num_rotors) {
-        std::vector<Rotor> tmp_rotors(num_rotors);
-        rotors_ = std::move(tmp_rotors);
-        config_ = Config(reflector_, rotors_);
+    explicit Enigma(int num_rotors) :
+        rotors_(num_rotors)
+    {
+        keystream_.Build(reflector_, rotors_);
     }
 
     explicit Enigma(std::string_view path) {
         LoadConfig(path);
+        keystream_.Build(reflector_, rotors_);
     }
 
     ~Enigma() = default;
 
 public:
+    /*
+        Every call starts from the initial rotor positions, so the keystream
+        built by the constructor is reused as is.
+    */
     void Encrypt(std::string_view path) {
-        ResetConfig();
-        
+        position_ = 0;
+
         auto file{fsm_.read_file(path)};
         if (!file.empty()) {
-            size_type size{file.size()};
-            std::vector<char> encoded(size);
-            int num_rotors{static_cast<int>(rotors_.size())};
+            std::string text{file.get_text()};
+            position_ = EncryptBuffer(0, text.data(), text.size()) % alphabet_size_;
 
-            for (size_type i{}; i < size; i++) {
-                int code{static_cast<int>(file[i])};
+            SaveFile(path, text);
+        }
+    }
 
-                if (code < 0 || code > 127) {
-                    encoded[i] = file[i];
-                    continue;
-                }
+    /*
+        Streaming variant for files too large to redo: the input is
+        processed in windows of GetStreamWindow() bytes and after every
+        window the output is flushed and a checkpoint (see EnigmaCheckpoint)
+        records how far it got. If a checkpoint for the same config and
+        input is found, the run continues from its offset instead of the
+        beginning. The checkpoint is removed once the output is complete.
+    */
+    void EncryptResumable(std::string_view path) {
+        fs::path in_path(path);
+        fs::path out_path{OutputPath(path)};
+        fs::path checkpoint_path{EnigmaCheckpoint::PathFor(out_path)};
+
+        std::ifstream in(in_path, std::ios::binary | std::ios::in);
+        if (!in.is_open())
+            throw std::ios_base::failure("Error: Cannot open file: " + in_path.filename().generic_string());
+
+        EnigmaCheckpoint checkpoint{ConfigHash(), fs::file_size(in_path), 0, 0};
+        auto saved{EnigmaCheckpoint::Load(checkpoint_path)};
+
+        if (saved && saved->config_hash == checkpoint.config_hash && saved->input_size == checkpoint.input_size &&
+            fs::exists(out_path) && fs::file_size(out_path) >= saved->offset) {
+            checkpoint = *saved;
+            fs::resize_file(out_path, checkpoint.offset);
+        } else {
+            std::ofstream(out_path, std::ios::binary | std::ios::out | std::ios::trunc);
+        }
 
-                for (int i{}; i < num_rotors; i++)
-                    code = rotors_[i][code];
+        std::fstream out(out_path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!out.is_open())
+            throw std::ios_base::failure("Error: Cannot create file: " + out_path.filename().generic_string());
 
-                code = reflector_[code];
+        in.seekg(static_cast<std::streamoff>(checkpoint.offset));
+        out.seekp(static_cast<std::streamoff>(checkpoint.offset));
 
-                for (int i{num_rotors - 1}; i >= 0; i--) {
-                    code = rotors_[i].Find(code);
-                    rotors_[i].Shift();
-                }
+        std::string buffer(stream_window_, '\0');
 
-                encoded[i] = static_cast<char>(code);
-            }
+        while (checkpoint.offset < checkpoint.input_size) {
+            auto size{static_cast<size_type>(std::min<uint64_t>(stream_window_, checkpoint.input_size - checkpoint.offset))};
+
+            if (!in.read(buffer.data(), static_cast<std::streamsize>(size)))
+                throw std::ios_base::failure("Error: Unexpected end of file: " + in_path.filename().generic_string());
+
+            checkpoint.position = (checkpoint.position + EncryptBuffer(checkpoint.position, buffer.data(), size)) % alphabet_size_;
+
+            if (!out.write(buffer.data(), static_cast<std::streamsize>(size)) || !out.flush())
+                throw std::ios_base::failure("Error: Cannot write file: " + out_path.filename().generic_string());
+
+            checkpoint.offset += size;
+            checkpoint.Save(checkpoint_path);
+        }
+
+        position_ = checkpoint.position;
+        fs::remove(checkpoint_path);
+    }
+
+    /*
+        Window of EncryptResumable, i.e. how much work a restart may redo.
+    */
+    void SetStreamWindow(size_type bytes) noexcept {
+        stream_window_ = bytes ? bytes : 1;
+    }
+
+    size_type GetStreamWindow() const noexcept { return stream_window_; }
+
+    /*
+        FNV-1a over the reflector and the rotor wirings and offsets.
+    */
+    uint64_t ConfigHash() const noexcept {
+        uint64_t hash{14695981039346656037ULL};
+        auto mix{[&hash](uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ULL;
+        }};
+
+        for (size_type i{}; i < alphabet_size_; ++i)
+            mix(static_cast<uint8_t>(reflector_[static_cast<int>(i)]));
+
+        for (const auto& rotor : rotors_) {
+            for (auto code : rotor.Wiring())
+                mix(code);
 
-            SaveFile(path, encoded);
+            mix(rotor.Offset());
         }
+
+        return hash;
+    }
+
+    /*
+        Number of worker threads (hardware concurrency by default).
+    */
+    void SetThreads(size_type threads) noexcept {
+        threads_ = threads ? threads : 1;
+    }
+
+    size_type GetThreads() const noexcept { return threads_; }
+
+    /*
+        Keystream kernel; kAuto picks the widest one the CPU supports.
+    */
+    void SetBackend(EnigmaBackend backend) noexcept {
+        backend_ = backend;
     }
 
+    EnigmaBackend GetBackend() const noexcept { return backend_; }
+
+    /*
+        Writes the rotors as they stand after the last Encrypt.
+    */
     void SaveConfig(std::string_view dir) const {
         fs::path fs_path(dir);
 
@@ -89,14 +186,42 @@ public:
 
         for (const auto& rotor : rotors_) {
             for (std::size_t i{}; i < alphabet_size_; ++i)
-                file << static_cast<int>(rotor[i]) << ' ';
+                file << static_cast<int>(rotor.Wiring()[(i - rotor.Offset() - position_) % alphabet_size_]) << ' ';
 
             file << '\n';
         }
     }
 
 private:
-    void SaveFile(std::string_view path, const std::vector<char>& cipher) const {
+    /*
+        Encrypts data[0, size) from machine step `position` in one chunk per
+        worker thread, each chunk starting from the step reached by the
+        bytes before it; returns the number of steps taken.
+    */
+    size_type EncryptBuffer(size_type position, char* data, size_type size) const {
+        size_type chunks{std::max<size_type>(1, std::min(threads_, size / min_chunk_size_))};
+        std::vector<size_type> offsets(chunks + 1);
+        offsets[0] = position;
+
+        auto chunk_begin{[&](size_type chunk) { return chunk * size / chunks; }};
+
+        Parallel::For(0, chunks, 1, threads_, [&](size_type begin, size_type end) {
+            for (size_type chunk{begin}; chunk < end; ++chunk)
+                offsets[chunk + 1] = EnigmaKeystream::Steps(data + chunk_begin(chunk), chunk_begin(chunk + 1) - chunk_begin(chunk));
+        });
+
+        for (size_type chunk{}; chunk < chunks; ++chunk)
+            offsets[chunk + 1] += offsets[chunk];
+
+        Parallel::For(0, chunks, 1, threads_, [&](size_type begin, size_type end) {
+            for (size_type chunk{begin}; chunk < end; ++chunk)
+                keystream_.EncryptAt(offsets[chunk], data + chunk_begin(chunk), chunk_begin(chunk + 1) - chunk_begin(chunk), backend_);
+        });
+
+        return offsets.back() - position;
+    }
+
+    static fs::path OutputPath(std::string_view path) {
         std::string postfix;
         auto encoded_pos{path.rfind("_encoded")};
         auto decoded_pos{path.rfind("_decoded")};
@@ -116,18 +241,17 @@ private:
         else
             filename += postfix;
 
-        fs::path full_path(filename);
+        return fs::path(filename);
+    }
+
+    void SaveFile(std::string_view path, std::string_view cipher) const {
+        fs::path full_path{OutputPath(path)};
         size_type size{cipher.size()};
 
         fsm_.create_file(file_t(full_path, cipher.data(), size));
     }
 
 private:
-    void ResetConfig() {
-        reflector_ = config_.reflector_conf;
-        rotors_ = config_.rotors_conf;
-    }
-
     void LoadConfig(std::string_view path) {
         fs::path fs_path(path);
         std::ifstream file(fs_path, std::ios::in);
@@ -151,33 +275,22 @@ private:
                 ++index;
             }
 
-            Rotor rotor(tmp_cfg);
-            rotors_.push_back(rotor);
+            rotors_.emplace_back(tmp_cfg);
         }
-
-        config_ = Config(reflector_, rotors_);
     }
 
 private:
-    struct Config {
-        Config() = default;
-
-        Config(const Reflector& refl, const std::vector<Rotor>& rot) :
-            reflector_conf(refl),
-            rotors_conf(rot)
-        {}
-
-        ~Config() = default;
-
-        Reflector reflector_conf;
-        std::vector<Rotor> rotors_conf;
-    };
-    
-private:
-    Config config_;
     Reflector reflector_;
     std::vector<Rotor> rotors_;
+    EnigmaKeystream keystream_;
+    size_type position_{};
     static constexpr const size_type alphabet_size_{128};
+    static constexpr const size_type min_chunk_size_{64 << 10};
+    static constexpr const size_type default_stream_window_{16 << 20};
+
+    size_type threads_{Parallel::DefaultThreads()};
+    EnigmaBackend backend_{EnigmaBackend::kAuto};
+    size_type stream_window_{default_stream_window_};
 
     tools::filesystem::monitoring fsm_;
 };
@@ -0,0 +1,277 @@
+#ifndef CRYPTO_MODEL_ENIGMA_KEYSTREAM_HPP
+#define CRYPTO_MODEL_ENIGMA_KEYSTREAM_HPP
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "rotor.hpp"
+#include "reflector.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRYPTO_ENIGMA_HAS_SIMD_PATH 1
+#include <immintrin.h>
+#else
+#define CRYPTO_ENIGMA_HAS_SIMD_PATH 0
+#endif
+
+namespace s21 {
+enum class EnigmaBackend : uint8_t { kAuto, kScalar, kAVX2, kAVX512 };
+
+/*
+    Every rotor steps once per 7-bit character, so the machine only has
+    128 states: step t applies the composite substitution
+        backward(reflector(forward(c))) with every rotor t positions on.
+    The 128 tables (16 KB) are built once, after which a character costs
+    one lookup and any run of characters can be encrypted on its own given
+    the number of steps before it. Bytes >= 128 pass through unchanged and
+    do not step the machine.
+
+    Neighbouring characters use different tables, so the vector kernels
+    gather from the whole 16 KB (row offset step * 128, plus the code) rather than
+    shuffle within one table. The AVX-512 kernel compresses the 7-bit
+    bytes of each 64-byte block together (VBMI2), looks them up with
+    consecutive steps and expands them back between the passed-through
+    bytes (blocks that are all 7-bit skip the compress and expand); the
+    AVX2 kernel handles 32-byte blocks of 7-bit bytes and leaves mixed
+    blocks to the scalar loop.
+*/
+class EnigmaKeystream {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type period{128};
+    static constexpr const size_type max_unrolled_rotors{8};
+
+public:
+    EnigmaKeystream() = default;
+
+    EnigmaKeystream(const Reflector& reflector, const std::vector<Rotor>& rotors) {
+        Build(reflector, rotors);
+    }
+
+    ~EnigmaKeystream() = default;
+
+public:
+    /*
+        Rebuilds the tables for a rotor set. Every count up to
+        max_unrolled_rotors gets its own instantiation, so the per-character
+        rotor loops have a constant trip count and unroll; larger sets take
+        the runtime loop.
+    */
+    void Build(const Reflector& reflector, const std::vector<Rotor>& rotors) noexcept {
+        switch (rotors.size()) {
+            case 1: return Build<1>(reflector, rotors.data(), 1);
+            case 2: return Build<2>(reflector, rotors.data(), 2);
+            case 3: return Build<3>(reflector, rotors.data(), 3);
+            case 4: return Build<4>(reflector, rotors.data(), 4);
+            case 5: return Build<5>(reflector, rotors.data(), 5);
+            case 6: return Build<6>(reflector, rotors.data(), 6);
+            case 7: return Build<7>(reflector, rotors.data(), 7);
+            case 8: return Build<8>(reflector, rotors.data(), 8);
+            default: return Build<0>(reflector, rotors.data(), rotors.size());
+        }
+    }
+
+    static bool HasAVX2() noexcept {
+#if CRYPTO_ENIGMA_HAS_SIMD_PATH
+        static const bool has_avx2{__builtin_cpu_supports("avx2") != 0};
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    static bool HasAVX512() noexcept {
+#if CRYPTO_ENIGMA_HAS_SIMD_PATH
+        static const bool has_avx512{__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                                     __builtin_cpu_supports("avx512vbmi2")};
+        return has_avx512;
+#else
+        return false;
+#endif
+    }
+
+    /*
+        kAuto picks the widest kernel the CPU supports: AVX-512 keeps up
+        with AVX2 on 7-bit text and is far ahead once bytes >= 128 appear.
+    */
+    static EnigmaBackend Resolve(EnigmaBackend backend) noexcept {
+        if (backend == EnigmaBackend::kAuto)
+            backend = EnigmaBackend::kAVX512;
+
+        if (backend == EnigmaBackend::kAVX512 && !HasAVX512())
+            backend = EnigmaBackend::kAVX2;
+
+        if (backend == EnigmaBackend::kAVX2 && !HasAVX2())
+            backend = EnigmaBackend::kScalar;
+
+        return backend;
+    }
+
+    /*
+        Encrypts data[0, size) in place as if the machine had already
+        stepped `offset` times; returns the number of steps taken.
+    */
+    size_type EncryptAt(size_type offset, char* data, size_type size, EnigmaBackend backend = EnigmaBackend::kAuto) const noexcept {
+        switch (Resolve(backend)) {
+#if CRYPTO_ENIGMA_HAS_SIMD_PATH
+            case EnigmaBackend::kAVX512:
+                return EncryptAVX512(offset, data, size);
+            case EnigmaBackend::kAVX2:
+                return EncryptAVX2(offset, data, size);
+#endif
+            default:
+                return EncryptScalar(offset, data, size);
+        }
+    }
+
+    /*
+        Number of steps a run of bytes advances the machine by.
+    */
+    static size_type Steps(const char* data, size_type size) noexcept {
+        size_type steps{};
+
+        for (size_type i{}; i < size; ++i)
+            steps += static_cast<unsigned char>(data[i]) < period;
+
+        return steps;
+    }
+
+    const uint8_t* Table(size_type step) const noexcept { return tables_.data() + (step & mask_) * period; }
+
+private:
+    /*
+        N == 0 is the runtime-count fallback.
+    */
+    template <size_type N>
+    void Build(const Reflector& reflector, const Rotor* rotors, size_type count) noexcept {
+        const size_type size{N ? N : count};
+
+        for (size_type step{}; step < period; ++step) {
+            for (size_type c{}; c < period; ++c) {
+                size_type code{c};
+
+                for (size_type i{}; i < size; ++i)
+                    code = rotors[i].Wiring()[(code - rotors[i].Offset() - step) & mask_];
+
+                code = static_cast<uint8_t>(reflector[static_cast<int>(code)]);
+
+                for (size_type i{size}; i-- > 0;)
+                    code = (rotors[i].Inverse()[code] + rotors[i].Offset() + step) & mask_;
+
+                tables_[step * period + c] = static_cast<uint8_t>(code);
+            }
+        }
+    }
+
+    size_type EncryptScalar(size_type offset, char* data, size_type size) const noexcept {
+        size_type step{offset & mask_};
+        size_type steps{};
+
+        for (size_type i{}; i < size; ++i) {
+            auto code{static_cast<unsigned char>(data[i])};
+
+            if (code >= period)
+                continue;
+
+            data[i] = static_cast<char>(tables_[step * period + code]);
+            step = (step + 1) & mask_;
+            ++steps;
+        }
+
+        return steps;
+    }
+
+#if CRYPTO_ENIGMA_HAS_SIMD_PATH
+    __attribute__((target("avx2")))
+    size_type EncryptAVX2(size_type offset, char* data, size_type size) const noexcept {
+        const auto* table{reinterpret_cast<const int*>(tables_.data())};
+        const __m256i ramp{_mm256_setr_epi32(0 << 7, 1 << 7, 2 << 7, 3 << 7, 4 << 7, 5 << 7, 6 << 7, 7 << 7)};
+        const __m256i low_byte{_mm256_set1_epi32(0xFF)};
+        const __m256i order{_mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)};
+        const __m256i step_mask{_mm256_set1_epi32(static_cast<int>(mask_ * period))};
+
+        size_type steps{};
+        size_type i{};
+
+        for (; i + 32 <= size; i += 32) {
+            __m256i bytes{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))};
+
+            if (_mm256_movemask_epi8(bytes)) {
+                steps += EncryptScalar(offset + steps, data + i, 32);
+                continue;
+            }
+
+            __m256i words[4];
+            for (int group{}; group < 4; ++group) {
+                __m128i codes{_mm_loadl_epi64(reinterpret_cast<const __m128i*>(data + i + group * 8))};
+                __m256i row{_mm256_add_epi32(ramp, _mm256_set1_epi32(static_cast<int>(((offset + steps + group * 8) & mask_) * period)))};
+                __m256i index{_mm256_or_si256(_mm256_and_si256(row, step_mask), _mm256_cvtepu8_epi32(codes))};
+
+                words[group] = _mm256_and_si256(_mm256_i32gather_epi32(table, index, 1), low_byte);
+            }
+
+            __m256i packed{_mm256_packus_epi16(_mm256_packus_epi32(words[0], words[1]), _mm256_packus_epi32(words[2], words[3]))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_permutevar8x32_epi32(packed, order));
+
+            steps += 32;
+        }
+
+        return steps + EncryptScalar(offset + steps, data + i, size - i);
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx512vbmi2")))
+    size_type EncryptAVX512(size_type offset, char* data, size_type size) const noexcept {
+        const auto* table{reinterpret_cast<const int*>(tables_.data())};
+        const __m512i ramp{_mm512_setr_epi32(0 << 7, 1 << 7, 2 << 7, 3 << 7, 4 << 7, 5 << 7, 6 << 7, 7 << 7,
+                                             8 << 7, 9 << 7, 10 << 7, 11 << 7, 12 << 7, 13 << 7, 14 << 7, 15 << 7)};
+        const __m512i step_mask{_mm512_set1_epi32(static_cast<int>(mask_ * period))};
+        const __m512i zero{_mm512_setzero_si512()};
+
+        alignas(64) char codes[64]{};
+
+        size_type steps{};
+        size_type i{};
+
+        for (; i + 64 <= size; i += 64) {
+            __m512i bytes{_mm512_loadu_si512(data + i)};
+            __mmask64 seven_bit{~_mm512_movepi8_mask(bytes)};
+            size_type count{static_cast<size_type>(__builtin_popcountll(seven_bit))};
+            const char* source{data + i};
+
+            if (count != 64) {
+                _mm512_store_si512(codes, _mm512_maskz_compress_epi8(seven_bit, bytes));
+                source = codes;
+            }
+
+            __m128i looked_up[4]{};
+            for (size_type group{}; group * 16 < count; ++group) {
+                __m512i row{_mm512_add_epi32(ramp, _mm512_set1_epi32(static_cast<int>(((offset + steps + group * 16) & mask_) * period)))};
+                __m512i code{_mm512_maskz_cvtepu8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + group * 16)))};
+                __m512i index{_mm512_or_si512(_mm512_and_si512(row, step_mask), code)};
+
+                looked_up[group] = _mm512_maskz_cvtepi32_epi8(0xFFFF, _mm512_mask_i32gather_epi32(zero, 0xFFFF, index, table, 1));
+            }
+
+            __m512i packed{_mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(_mm512_inserti32x4(zero, looked_up[0], 0), looked_up[1], 1), looked_up[2], 2), looked_up[3], 3)};
+            _mm512_storeu_si512(data + i, count == 64 ? packed : _mm512_mask_expand_epi8(bytes, seven_bit, packed));
+
+            steps += count;
+        }
+
+        return steps + EncryptScalar(offset + steps, data + i, size - i);
+    }
+#endif
+
+private:
+    static constexpr const size_type mask_{period - 1};
+    static constexpr const size_type gather_padding_{4};
+
+    alignas(64) std::array<uint8_t, period * period + gather_padding_> tables_{};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_ENIGMA_KEYSTREAM_HPP
@@ -1,7 +1,7 @@
 #ifndef CRYPTO_MODEL_ENIGMA_REFLECTOR_HPP
 #define CRYPTO_MODEL_ENIGMA_REFLECTOR_HPP
 
-#include <vector>
+#include <array>
 
 #include "tools.hpp"
 
@@ -24,7 +24,7 @@ public:
     }
 
 private:
-    std::vector<char> data_ {
+    std::array<char, 128> data_ {
         127, 126, 125, 124, 123, 122, 121, 120,
         119, 118, 117, 116, 115, 114, 113, 112,
         111, 110, 109, 108, 107, 106, 105, 104,
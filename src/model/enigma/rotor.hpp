@@ -1,70 +1,94 @@
 #ifndef CRYPTO_MODEL_ENIGMA_ROTOR_HPP
 #define CRYPTO_MODEL_ENIGMA_ROTOR_HPP
 
+#include <array>
+#include <string>
 #include <vector>
+#include <numeric>
+#include <cstdint>
+#include <stdexcept>
 
 #include "tools.hpp"
 
 namespace s21 {
+/*
+    A rotor is a fixed wiring plus a rotation offset. Shifting by one
+    position moves every entry one slot up, so after `offset` shifts
+    entry i holds wiring[i - offset] and the entry holding `code` sits at
+    inverse[code] + offset (mod 128): both directions are one lookup and
+    Shift() is an increment.
+*/
 class Rotor {
 public:
     using size_type = std::size_t;
+    using table_type = std::array<uint8_t, 128>;
 
 public:
     Rotor() {
-        tools::random::shuffle(data_.begin(), data_.end());
+        std::iota(wiring_.begin(), wiring_.end(), 0);
+        tools::random::shuffle(wiring_.begin(), wiring_.end());
+        BuildInverse();
     }
 
     explicit Rotor(const std::vector<char>& config) {
-        data_ = config;
+        if (config.size() != size_)
+            throw std::invalid_argument("Rotor needs " + std::to_string(size_) + " codes");
+
+        for (size_type i{}; i < size_; ++i)
+            wiring_[i] = static_cast<uint8_t>(config[i]);
+
+        BuildInverse();
     }
 
     ~Rotor() = default;
 
 public:
-    char& operator[](int index) {
-        return data_[index];
-    }
-
     char operator[](int index) const {
-        return data_[index];
+        return static_cast<char>(wiring_[(static_cast<size_type>(index) - offset_) & mask_]);
     }
 
 public:
-    void Shift() {
-        char tmp{data_[size_ - 1]};
-
-        for (size_type i{size_ - 1}; i > 0; i--)
-            data_[i] = data_[i - 1];
+    void Shift() noexcept {
+        offset_ = (offset_ + 1) & mask_;
+    }
 
-        data_[0] = tmp;
+    void Shift(size_type steps) noexcept {
+        offset_ = (offset_ + steps) & mask_;
     }
 
     int Find(char code) const {
-        for (size_type i{}; i < size_; i++)
-            if (data_[i] == code)
-                return static_cast<int>(i);
+        if (code < 0)
+            throw std::invalid_argument("Incorrect code: " + std::to_string(code));
 
-        throw std::invalid_argument("Incorrect code: " + std::to_string(code));
+        return static_cast<int>((inverse_[static_cast<size_type>(code)] + offset_) & mask_);
+    }
+
+    const table_type& Wiring() const noexcept { return wiring_; }
+
+    const table_type& Inverse() const noexcept { return inverse_; }
+
+    size_type Offset() const noexcept { return offset_; }
+
+private:
+    void BuildInverse() {
+        std::array<bool, 128> seen{};
+
+        for (size_type i{}; i < size_; ++i) {
+            if (wiring_[i] >= size_ || seen[wiring_[i]])
+                throw std::invalid_argument("Rotor wiring must be a permutation of 0..127");
+
+            seen[wiring_[i]] = true;
+            inverse_[wiring_[i]] = static_cast<uint8_t>(i);
+        }
     }
 
 private:
-    std::vector<char> data_ {
-        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
-        11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
-        21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
-        31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50,
-        51, 52, 53, 54, 55, 56, 57, 58, 59, 60,
-        61, 62, 63, 64, 65, 66, 67, 68, 69, 70,
-        71, 72, 73, 74, 75, 76, 77, 78, 79, 80,
-        81, 82, 83, 84, 85, 86, 87, 88, 89, 90,
-        91, 92, 93, 94, 95, 96, 97, 98, 99, 100,
-        101, 102, 103, 104, 105, 106, 107, 108, 109,
-        110, 111, 112, 113, 114, 115, 116, 117, 118,
-        119, 120, 121, 122, 123, 124, 125, 126, 127
-    };
     static constexpr const size_type size_{128};
+    static constexpr const size_type mask_{size_ - 1};
+
+    table_type wiring_{};
+    table_type inverse_{};
+    size_type offset_{};
 };
 } // namespace s21
 
@@ -1,255 +1,440 @@
 #ifndef CRYPTO_MODEL_HUFFMAN_HUFFMAN_HPP
 #define CRYPTO_MODEL_HUFFMAN_HUFFMAN_HPP
 
-#include <queue>
-#include <vector>
+#include <array>
 #include <string>
-#include <fstream>
-#include <sstream>
-#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
 
 #include "tools.hpp"
 
+#include "huffman_container.hpp"
+
 namespace s21 {
 class Huffman {
+public:
+    using size_type = std::size_t;
+
 private:
     using file_t = tools::filesystem::file_t;
+    using lengths_type = std::array<uint8_t, 256>;
 
 private:
+    /*
+        Tree nodes live in a flat arena: the leaves first, then one parent
+        per merge, so a tree over bytes never needs more than 511 nodes and
+        children are arena indices. Leaves have no_child_ for both.
+    */
     struct Node {
-    public:
-        Node() :
-            value('\0'),
-            frequency(0),
-            left(nullptr),
-            right(nullptr)
-        {}
-
-        explicit Node(char val, int freq) :
-            value(val),
-            frequency(freq),
-            left(nullptr),
-            right(nullptr)
-        {}
-
-        explicit Node(char val, int freq, Node* l_child, Node* r_child) :
-            value(val),
-            frequency(freq),
-            left(l_child),
-            right(r_child)
-        {}
-
-        ~Node() = default;
-
-        char value{};
-        int frequency{};
-        Node* left{nullptr};
-        Node* right{nullptr};
+        std::size_t frequency{};
+        uint16_t left{};
+        uint16_t right{};
+        uint8_t value{};
     };
 
-    struct Comp {
-        bool operator()(Node* left, Node* right) {
-            return left->frequency > right->frequency;
-        }
+    struct Code {
+        uint32_t code{};
+        uint8_t length{};
     };
 
     enum class Mode : bool { kEncode, kDecode };
 
 public:
     Huffman() = default;
-
-    ~Huffman() {
-        Clear(root_);
-    }
+    ~Huffman() = default;
 
 public:
+    /*
+        Writes "<name>_encoded<ext>": a HuffmanContainer header with the
+        canonical code lengths, followed by the bit-packed codes.
+    */
     void Encode(std::string_view path) {
         ResetState();
 
-        root_ = CreateTree(path);
+        auto file{fsm_.read_file(fs::path(path))};
+        if (!file.exists())
+            throw std::ios_base::failure("Error: Cannot open file: " + fs::path(path).filename().generic_string());
+
+        decoded_text_ = file.get_text();
 
-        CalculateHuffmanCodes(root_, "");
+        HuffmanHeader header;
+        header.length = decoded_text_.size();
 
-        for (auto let : decoded_text_)
-            encoded_text_ += huffman_codes_[let];
+        if (!decoded_text_.empty()) {
+            std::array<size_type, 256> lengths{};
+            CalculateCodeLengths(CreateTree(), lengths);
+
+            header.code_lengths = LimitLengths(lengths);
+            AssignCanonicalCodes(header.code_lengths);
+        }
+
+        encoded_text_.assign(HuffmanContainer::header_size, '\0');
+        HuffmanContainer::WriteHeader(header, encoded_text_.data());
+        EncryptText();
 
         SaveFile(path, Mode::kEncode);
-        SaveConfig(path);
     }
 
-    void Decode(std::string_view path_file, std::string_view path_config) {
-        if (fs::path(path_config).extension() != ".cfg")
-            throw std::invalid_argument("The configuration file does not have a .cfg extension");
-
+    /*
+        Everything needed is in the file itself; writes "<name>_decoded<ext>".
+    */
+    void Decode(std::string_view path) {
         ResetState();
 
-        root_ = LoadConfig(path_config);
-
-        auto file{fsm_.read_file(path_file)};
+        auto file{fsm_.read_file(fs::path(path))};
         encoded_text_ = file.get_text();
 
-        int index{-1};
-        int size{static_cast<int>(encoded_text_.size()) - 2};
-        while (index < size)
-            DecryptText(root_, encoded_text_, index);
+        HuffmanHeader header{HuffmanContainer::ReadHeader(encoded_text_)};
+        DecryptText(header);
 
-        SaveFile(path_file, Mode::kDecode);
+        SaveFile(path, Mode::kDecode);
     }
 
 private:
-    Node* CreateTree(std::string_view path) {
-        auto file{fsm_.read_file(fs::path(path))};
-        decoded_text_ = file.get_text();
-        std::unordered_map<char, int> frequency;
-
+    /*
+        Builds the tree in nodes_ and returns the root index. The queue is a
+        binary heap of node indices in a fixed array; equal frequencies are
+        taken in arena order so the tree does not depend on the heap layout.
+    */
+    uint16_t CreateTree() {
         for (char ch : decoded_text_)
-            frequency[ch]++;
+            ++frequency_[static_cast<unsigned char>(ch)];
+
+        std::array<uint16_t, 256> heap{};
+        size_type heap_size{};
+
+        for (size_type symbol{}; symbol < frequency_.size(); ++symbol) {
+            if (frequency_[symbol]) {
+                nodes_[node_count_] = Node{frequency_[symbol], no_child_, no_child_, static_cast<uint8_t>(symbol)};
+                heap[heap_size++] = static_cast<uint16_t>(node_count_++);
+            }
+        }
 
-        std::priority_queue<Node*, std::vector<Node*>, Comp> queue;
+        auto later{[this](uint16_t a, uint16_t b) {
+            return nodes_[a].frequency > nodes_[b].frequency || (nodes_[a].frequency == nodes_[b].frequency && a > b);
+        }};
 
-        for (auto [value, num] : frequency)
-            queue.push(new Node(value, num));
+        std::make_heap(heap.begin(), heap.begin() + heap_size, later);
 
-        while (queue.size() != 1) {
-            Node *left = queue.top();
-            queue.pop();
+        while (heap_size > 1) {
+            std::pop_heap(heap.begin(), heap.begin() + heap_size--, later);
+            uint16_t left{heap[heap_size]};
 
-            Node *right = queue.top();
-            queue.pop();
+            std::pop_heap(heap.begin(), heap.begin() + heap_size--, later);
+            uint16_t right{heap[heap_size]};
 
-            int sum = left->frequency + right->frequency;
-            queue.push(new Node('\0', sum, left, right));
+            nodes_[node_count_] = Node{nodes_[left].frequency + nodes_[right].frequency, left, right, 0};
+            heap[heap_size++] = static_cast<uint16_t>(node_count_++);
+            std::push_heap(heap.begin(), heap.begin() + heap_size, later);
         }
 
-        return queue.top();
+        return heap[0];
     }
 
-    void CalculateHuffmanCodes(Node* node, std::string str) {
-        if (!node)
-            return;
-
-        if (!node->left && !node->right) {
-            huffman_codes_[node->value] = str;
-            return;
+    /*
+        Leaf depths; a lone leaf still gets a 1-bit code. Parents come after
+        their children in the arena, so one backward pass from the root
+        reaches every node after its parent.
+    */
+    void CalculateCodeLengths(uint16_t root, std::array<size_type, 256>& lengths) const {
+        std::array<size_type, max_nodes_> depth{};
+
+        for (size_type index{size_type{root} + 1}; index-- > 0;) {
+            const Node& node{nodes_[index]};
+
+            if (node.left == no_child_) {
+                lengths[node.value] = std::max<size_type>(depth[index], 1);
+            } else {
+                depth[node.left] = depth[index] + 1;
+                depth[node.right] = depth[index] + 1;
+            }
         }
-
-        CalculateHuffmanCodes(node->left, str + "0");
-        CalculateHuffmanCodes(node->right, str + "1");
     }
 
-    void DecryptText(Node* node, std::string_view str, int &index) {
-        if (!node)
-            return;
+    /*
+        Canonical codes: shorter codes first, equal lengths in byte order,
+        each code the previous one plus one (shifted left when the length
+        grows).
+    */
+    void AssignCanonicalCodes(const lengths_type& lengths) {
+        auto next_code{FirstCodes(lengths)};
+
+        for (size_type symbol{}; symbol < lengths.size(); ++symbol)
+            if (lengths[symbol])
+                huffman_codes_[symbol] = Code{static_cast<uint32_t>(next_code[lengths[symbol]]++), lengths[symbol]};
+    }
 
-        if (!node->left && !node->right) {
-            decoded_text_ += node->value;
-            return;
+    /*
+        Appends the codes of decoded_text_ to encoded_text_. Codes are ORed
+        into a 64-bit accumulator below the bits still pending (fewer than
+        8), four symbols at a time so at most 7 + 4 * 12 bits are held; then
+        the accumulator is stored as a whole big-endian word and advanced by
+        the complete bytes, with no branch on the bit count.
+    */
+    void EncryptText() {
+        size_type offset{encoded_text_.size()};
+        encoded_text_.resize(offset + decoded_text_.size() * HuffmanContainer::max_code_length / 8 + 16);
+
+        const auto* in{reinterpret_cast<const unsigned char*>(decoded_text_.data())};
+        const auto* in_end{in + decoded_text_.size()};
+        char* out{encoded_text_.data() + offset};
+        uint64_t accumulator{};
+        size_type pending{};
+
+        auto put{[&](unsigned char symbol) noexcept {
+            const Code& code{huffman_codes_[symbol]};
+            pending += code.length;
+            accumulator |= static_cast<uint64_t>(code.code) << (64 - pending);
+        }};
+
+        auto flush{[&]() noexcept {
+            for (size_type i{}; i < 8; ++i)
+                out[i] = static_cast<char>(accumulator >> (56 - i * 8));
+
+            out += pending >> 3;
+            accumulator <<= pending & ~size_type{7};
+            pending &= 7;
+        }};
+
+        for (; in_end - in >= 4; in += 4) {
+            put(in[0]);
+            put(in[1]);
+            put(in[2]);
+            put(in[3]);
+            flush();
         }
 
-        index++;
+        for (; in < in_end; ++in) {
+            put(*in);
+            flush();
+        }
 
-        if (str[index] == '0')
-            DecryptText(node->left, str, index);
-        else
-            DecryptText(node->right, str, index);
+        encoded_text_.resize(static_cast<size_type>(out - encoded_text_.data()) + (pending + 7) / 8);
     }
 
-private:
-    void SaveFile(std::string_view path, Mode mode) {
-        std::string postfix{mode == Mode::kEncode ? "_encoded" : "_decoded"};
-        std::string filename(path);
+    /*
+        Caps the tree's code lengths at max_code_length bits. The counts per
+        length are rebalanced as in JPEG (Annex K.3): two leaves below the cap
+        are replaced by one a level up, and a shallower leaf is split into two,
+        which keeps the code complete. The new lengths then go to the symbols
+        by decreasing frequency.
+    */
+    lengths_type LimitLengths(const std::array<size_type, 256>& lengths) const {
+        lengths_type limited{};
+        std::array<size_type, 257> count{};
+        size_type max_length{};
+
+        for (auto length : lengths) {
+            if (length) {
+                ++count[length];
+                max_length = std::max(max_length, length);
+            }
+        }
 
-        auto pos{filename.find_last_of(".")};
-        if (pos != std::string_view::npos)
-            filename.insert(pos, postfix);
-        else
-            filename += postfix;
+        if (max_length <= HuffmanContainer::max_code_length) {
+            std::copy(lengths.begin(), lengths.end(), limited.begin());
+            return limited;
+        }
 
-        if (mode == Mode::kEncode)
-            fsm_.create_file(file_t(fs::path(filename), encoded_text_));
-        else
-            fsm_.create_file(file_t(fs::path(filename), decoded_text_));
-    }
+        for (size_type length{max_length}; length > HuffmanContainer::max_code_length; --length) {
+            while (count[length]) {
+                size_type shallower{length - 2};
+                while (!count[shallower])
+                    --shallower;
 
-    void SaveConfig(std::string_view path) {
-        std::string filename(path);
-        auto pos{filename.find_last_of(".")};
-        if (pos != std::string_view::npos)
-            filename.insert(pos, "_encoded_huffman");
-        else
-            filename += "_encoded_huffman";
+                count[length] -= 2;
+                ++count[length - 1];
+                count[shallower + 1] += 2;
+                --count[shallower];
+            }
+        }
 
-        std::ostringstream string_stream;
+        std::array<uint16_t, 256> symbols{};
+        size_type num_symbols{};
+        for (size_type symbol{}; symbol < lengths.size(); ++symbol)
+            if (lengths[symbol])
+                symbols[num_symbols++] = static_cast<uint16_t>(symbol);
 
-        for (const auto& [value, code] : huffman_codes_)
-            string_stream << static_cast<int>(value) << ' ' << code << '\n';
+        std::sort(symbols.begin(), symbols.begin() + num_symbols, [this](uint16_t a, uint16_t b) {
+            return frequency_[a] > frequency_[b] || (frequency_[a] == frequency_[b] && a < b);
+        });
 
-        fs::path config_path{fs::path(filename).replace_extension("cfg")};
+        size_type length{1};
+        for (size_type i{}; i < num_symbols; ++i) {
+            size_type symbol{symbols[i]};
 
-        fsm_.create_file(file_t(config_path, string_stream.str()));
-    }
+            while (!count[length])
+                ++length;
 
-    Node* LoadConfig(std::string_view path) {
-        std::ifstream file(fs::path(path), std::ios::in);
+            limited[symbol] = static_cast<uint8_t>(length);
+            --count[length];
+        }
 
-        if (!file.is_open())
-            return nullptr;
+        return limited;
+    }
 
-        int symbol_code{};
-        std::string code;
+    /*
+        Fills decode_table_, indexed by the next max_code_length bits of the
+        stream: byte 0 is the first symbol and byte 2 its length; when the
+        next code fits in the same bits too, byte 1 is that symbol and byte 3
+        the length of both. Unused bit patterns stay 0.
+    */
+    void BuildDecodeTable(const lengths_type& lengths) {
+        constexpr size_type bits{HuffmanContainer::max_code_length};
+        auto next_code{FirstCodes(lengths)};
+
+        decode_table_.fill(0);
+
+        for (size_type symbol{}; symbol < lengths.size(); ++symbol) {
+            size_type length{lengths[symbol]};
+            if (!length)
+                continue;
+
+            size_type code{static_cast<size_type>(next_code[length]++)};
+            std::fill(decode_table_.begin() + (code << (bits - length)), decode_table_.begin() + ((code + 1) << (bits - length)),
+                      static_cast<uint32_t>(symbol | length << 16));
+        }
 
-        Node* root_node{new Node()};
+        for (size_type index{}; index < decode_table_.size(); ++index) {
+            uint32_t first_length{(decode_table_[index] >> 16) & 0xFF};
+            if (!first_length)
+                continue;
 
-        while (file >> symbol_code >> code) {
-            Node* current{root_node};
-            for (auto var : code) {
-                if (var == '0') {
-                    if (!current->left)
-                        current->left = new Node();
+            uint32_t second{decode_table_[(index << first_length) & (decode_table_.size() - 1)]};
+            uint32_t both_length{first_length + ((second >> 16) & 0xFF)};
 
-                    current = current->left;
-                } else if (var == '1') {
-                    if (!current->right)
-                        current->right = new Node();
+            if (both_length > first_length && both_length <= bits)
+                decode_table_[index] |= (second & 0xFF) << 8 | both_length << 24;
+        }
+    }
 
-                    current = current->right;
-                } else {
-                    return nullptr;
-                }
+    /*
+        One table lookup per one or two symbols. The bits sit MSB-first in a
+        64-bit buffer that is refilled with a single 8-byte load whenever it
+        runs below 57 bits, so each refill serves four lookups; the body is
+        padded with zero bytes so the loads never run past it.
+    */
+    void DecryptText(const HuffmanHeader& header) {
+        constexpr size_type bits{HuffmanContainer::max_code_length};
+
+        size_type body_bits{(encoded_text_.size() - HuffmanContainer::header_size) * 8};
+
+        if (header.length > body_bits)
+            throw std::invalid_argument("Corrupted Huffman data: header length exceeds the stream");
+
+        BuildDecodeTable(header.code_lengths);
+        encoded_text_.append(16, '\0');
+
+        const auto* in{reinterpret_cast<const unsigned char*>(encoded_text_.data()) + HuffmanContainer::header_size};
+        uint64_t buffer{};
+        size_type buffered{};
+        size_type consumed{};
+
+        auto refill{[&]() noexcept {
+            uint64_t word{};
+            for (size_type i{}; i < 8; ++i)
+                word = (word << 8) | in[i];
+
+            buffer |= word >> buffered;
+            in += (63 - buffered) >> 3;
+            buffered |= 56;
+        }};
+
+        decoded_text_.resize(header.length);
+        char* out{decoded_text_.data()};
+        char* out_end{out + decoded_text_.size()};
+
+        auto decode{[&](bool allow_pair) {
+            uint32_t entry{decode_table_[buffer >> (64 - bits)]};
+            uint32_t length{(entry >> 16) & 0xFF};
+
+            if (!length)
+                throw std::invalid_argument("Corrupted Huffman data: invalid code");
+
+            *out++ = static_cast<char>(entry);
+            if (allow_pair && entry >> 24) {
+                *out++ = static_cast<char>(entry >> 8);
+                length = entry >> 24;
             }
 
-            if (current && !current->left && !current->right)
-                current->value = static_cast<char>(symbol_code);
+            buffer <<= length;
+            buffered -= length;
+            consumed += length;
+        }};
+
+        while (out_end - out >= 8) {
+            refill();
+
+            for (int i{}; i < 4; ++i)
+                decode(true);
+
+            if (consumed > body_bits)
+                break;
         }
 
-        return root_node;
+        while (out < out_end && consumed <= body_bits) {
+            refill();
+            decode(out_end - out >= 2);
+        }
+
+        if (consumed > body_bits)
+            throw std::invalid_argument("Corrupted Huffman data: stream ends early");
+    }
+
+    static std::array<uint64_t, HuffmanContainer::max_code_length + 1> FirstCodes(const lengths_type& lengths) {
+        std::array<size_type, HuffmanContainer::max_code_length + 1> count{};
+        std::array<uint64_t, HuffmanContainer::max_code_length + 1> first{};
+
+        for (auto length : lengths)
+            ++count[length];
+
+        count[0] = 0;
+        for (size_type length{1}; length <= HuffmanContainer::max_code_length; ++length)
+            first[length] = (first[length - 1] + count[length - 1]) << 1;
+
+        return first;
     }
 
 private:
-    void Clear(Node* node) {
-        if (node) {
-            Clear(node->left);
-            Clear(node->right);
+    void SaveFile(std::string_view path, Mode mode) {
+        std::string postfix{mode == Mode::kEncode ? "_encoded" : "_decoded"};
+        std::string filename(path);
 
-            delete node;
-            node = nullptr;
-        }
+        auto pos{filename.find_last_of(".")};
+        if (pos != std::string_view::npos)
+            filename.insert(pos, postfix);
+        else
+            filename += postfix;
+
+        if (mode == Mode::kEncode)
+            fsm_.create_file(file_t(fs::path(filename), encoded_text_));
+        else
+            fsm_.create_file(file_t(fs::path(filename), decoded_text_));
     }
 
+private:
     void ResetState() {
-        Clear(root_);
+        node_count_ = 0;
 
         decoded_text_ = std::string();
         encoded_text_ = std::string();
-        huffman_codes_.clear();
+        frequency_.fill(0);
+        huffman_codes_.fill(Code{});
     }
 
 private:
-    Node* root_{nullptr};
+    static constexpr const size_type max_nodes_{511};
+    static constexpr const uint16_t no_child_{0xFFFF};
+
+    std::array<Node, max_nodes_> nodes_{};
+    size_type node_count_{};
 
     std::string decoded_text_;
     std::string encoded_text_;
-    std::unordered_map<char, std::string> huffman_codes_;
+    std::array<Code, 256> huffman_codes_{};
+    std::array<size_type, 256> frequency_{};
+    std::array<uint32_t, size_type{1} << HuffmanContainer::max_code_length> decode_table_{};
 
     tools::filesystem::monitoring fsm_;
 };
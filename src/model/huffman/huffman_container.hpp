@@ -0,0 +1,111 @@
+#ifndef CRYPTO_MODEL_HUFFMAN_HUFFMAN_CONTAINER_HPP
+#define CRYPTO_MODEL_HUFFMAN_HUFFMAN_CONTAINER_HPP
+
+#include <array>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace s21 {
+struct HuffmanHeader {
+    uint8_t version{1};
+    uint64_t length{};
+    std::array<uint8_t, 256> code_lengths{};
+};
+
+/*
+    Compressed Huffman file:
+
+        offset  size  field
+        0       4     magic "S21H"
+        4       1     version
+        5       3     reserved (0)
+        8       8     original length, little-endian
+        16      256   code length of every byte value (0 = unused)
+        272     ...   codes, bit-packed MSB first, last byte zero-padded
+
+    The codes are canonical, so the lengths are all the decoder needs to
+    rebuild them, and at most max_code_length bits long so that it can
+    decode through a single table.
+*/
+class HuffmanContainer {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type header_size{272};
+    static constexpr const uint8_t version{1};
+    static constexpr const size_type max_code_length{12};
+
+public:
+    static bool IsContainer(std::string_view data) noexcept {
+        return data.size() >= header_size && data.substr(0, magic_.size()) == magic_ &&
+               static_cast<uint8_t>(data[4]) == version;
+    }
+
+    static void WriteHeader(const HuffmanHeader& header, char* out) noexcept {
+        std::memset(out, 0, header_size);
+        std::memcpy(out, magic_.data(), magic_.size());
+        out[4] = static_cast<char>(header.version);
+
+        for (size_type i{}; i < 8; ++i)
+            out[8 + i] = static_cast<char>((header.length >> (i * 8)) & 0xFF);
+
+        std::memcpy(out + 16, header.code_lengths.data(), header.code_lengths.size());
+    }
+
+    static HuffmanHeader ReadHeader(std::string_view data) {
+        if (!IsContainer(data))
+            throw std::invalid_argument("Not a Huffman container");
+
+        HuffmanHeader header;
+        header.version = static_cast<uint8_t>(data[4]);
+
+        for (size_type i{}; i < 8; ++i)
+            header.length |= static_cast<uint64_t>(static_cast<unsigned char>(data[8 + i])) << (i * 8);
+
+        std::memcpy(header.code_lengths.data(), data.data() + 16, header.code_lengths.size());
+
+        CheckLengths(header);
+
+        return header;
+    }
+
+private:
+    /*
+        The lengths must describe a prefix code (Kraft sum <= 1), and a
+        non-empty input needs at least one code.
+    */
+    static void CheckLengths(const HuffmanHeader& header) {
+        std::array<size_type, max_code_length + 1> count{};
+
+        for (auto length : header.code_lengths) {
+            if (length > max_code_length)
+                throw std::invalid_argument("Corrupted Huffman header: code length " + std::to_string(length));
+
+            ++count[length];
+        }
+
+        if (header.length && count[0] == header.code_lengths.size())
+            throw std::invalid_argument("Corrupted Huffman header: no codes");
+
+        uint64_t left{1};
+        for (size_type length{1}; length <= max_code_length; ++length) {
+            left <<= 1;
+
+            if (count[length] > left)
+                throw std::invalid_argument("Corrupted Huffman header: code lengths do not form a prefix code");
+
+            left -= count[length];
+        }
+    }
+
+private:
+    static constexpr const std::string_view magic_{"S21H"};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_HUFFMAN_HUFFMAN_CONTAINER_HPP
@@ -0,0 +1,505 @@
+#ifndef CRYPTO_MODEL_RSA_BIGINT_HPP
+#define CRYPTO_MODEL_RSA_BIGINT_HPP
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <charconv>
+#include <system_error>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+namespace s21 {
+/*
+    Non-negative arbitrary-precision integer: little-endian 64-bit limbs,
+    no high zero limbs (zero has none). Products and quotients go through
+    unsigned __int128.
+*/
+class BigInt {
+public:
+    using limb_type  = uint64_t;
+    using wide_type  = unsigned __int128;
+    using size_type  = std::size_t;
+    using limbs_type = std::vector<limb_type>;
+
+public:
+    static constexpr const size_type limb_bits{64};
+
+public:
+    BigInt() = default;
+
+    BigInt(uint64_t value) {
+        if (value)
+            limbs_.push_back(value);
+    }
+
+    explicit BigInt(limbs_type limbs) :
+        limbs_(std::move(limbs))
+    {
+        Normalize();
+    }
+
+    ~BigInt() = default;
+
+public:
+    /*
+        Decimal text, parsed and printed 19 digits (one limb-sized chunk)
+        at a time with std::from_chars / std::to_chars.
+    */
+    static BigInt FromString(std::string_view text) {
+        if (text.empty())
+            throw std::invalid_argument("Empty number");
+
+        BigInt result;
+
+        for (size_type i{}; i < text.size(); i += decimal_chunk_digits_) {
+            std::string_view chunk{text.substr(i, decimal_chunk_digits_)};
+            uint64_t value{};
+
+            auto [end, error]{std::from_chars(chunk.data(), chunk.data() + chunk.size(), value)};
+            if (error != std::errc{} || end != chunk.data() + chunk.size())
+                throw std::invalid_argument("Invalid decimal number: " + std::string(text));
+
+            result.MulAddSmall(Power10(chunk.size()), value);
+        }
+
+        return result;
+    }
+
+    void AppendString(std::string& out) const {
+        if (IsZero()) {
+            out += '0';
+            return;
+        }
+
+        BigInt value{*this};
+        std::vector<uint64_t> chunks;
+
+        while (!value.IsZero())
+            chunks.push_back(value.DivSmall(decimal_chunk_));
+
+        char buffer[decimal_chunk_digits_ + 1];
+        char* end{std::to_chars(buffer, buffer + sizeof(buffer), chunks.back()).ptr};
+        out.append(buffer, end);
+
+        for (size_type i{chunks.size() - 1}; i-- > 0;) {
+            end = std::to_chars(buffer, buffer + sizeof(buffer), chunks[i]).ptr;
+            out.append(decimal_chunk_digits_ - static_cast<size_type>(end - buffer), '0');
+            out.append(buffer, end);
+        }
+    }
+
+    std::string ToString() const {
+        std::string result;
+        AppendString(result);
+
+        return result;
+    }
+
+    /*
+        Uniform in [0, 2^bits).
+    */
+    template <typename Engine>
+    static BigInt Random(size_type bits, Engine& engine) {
+        std::uniform_int_distribution<uint64_t> distribution;
+        limbs_type limbs((bits + limb_bits - 1) / limb_bits);
+
+        for (auto& limb : limbs)
+            limb = distribution(engine);
+
+        if (bits % limb_bits)
+            limbs.back() &= (limb_type{1} << (bits % limb_bits)) - 1;
+
+        return BigInt(std::move(limbs));
+    }
+
+    /*
+        Big-endian byte string <-> integer (PKCS #1 OS2IP / I2OSP).
+    */
+    static BigInt FromBytes(const unsigned char* data, size_type size) {
+        limbs_type limbs((size + sizeof(limb_type) - 1) / sizeof(limb_type));
+
+        for (size_type i{}; i < size; ++i)
+            limbs[i / sizeof(limb_type)] |= static_cast<limb_type>(data[size - 1 - i]) << (i % sizeof(limb_type) * 8);
+
+        return BigInt(std::move(limbs));
+    }
+
+    void ToBytes(unsigned char* out, size_type size) const {
+        if ((BitLength() + 7) / 8 > size)
+            throw std::invalid_argument("BigInt does not fit into " + std::to_string(size) + " bytes");
+
+        for (size_type i{}; i < size; ++i)
+            out[size - 1 - i] = static_cast<unsigned char>(Limb(i / sizeof(limb_type)) >> (i % sizeof(limb_type) * 8));
+    }
+
+    /*
+        Fixed-width little-endian bytes, the layout of the binary RSA
+        container.
+    */
+    static BigInt FromLittleEndian(const char* data, size_type size) {
+        limbs_type limbs((size + sizeof(limb_type) - 1) / sizeof(limb_type));
+
+        for (size_type i{}; i < size; ++i)
+            limbs[i / sizeof(limb_type)] |= static_cast<limb_type>(static_cast<unsigned char>(data[i])) << (i % sizeof(limb_type) * 8);
+
+        return BigInt(std::move(limbs));
+    }
+
+    void ToLittleEndian(char* out, size_type size) const {
+        if ((BitLength() + 7) / 8 > size)
+            throw std::invalid_argument("BigInt does not fit into " + std::to_string(size) + " bytes");
+
+        for (size_type i{}; i < size; ++i)
+            out[i] = static_cast<char>(Limb(i / sizeof(limb_type)) >> (i % sizeof(limb_type) * 8));
+    }
+
+public:
+    bool IsZero() const noexcept { return limbs_.empty(); }
+
+    bool IsOdd() const noexcept { return !limbs_.empty() && (limbs_[0] & 1); }
+
+    size_type size() const noexcept { return limbs_.size(); }
+
+    const limbs_type& Limbs() const noexcept { return limbs_; }
+
+    limb_type Limb(size_type index) const noexcept { return index < limbs_.size() ? limbs_[index] : 0; }
+
+    size_type BitLength() const noexcept {
+        return limbs_.empty() ? 0 : limbs_.size() * limb_bits - static_cast<size_type>(__builtin_clzll(limbs_.back()));
+    }
+
+    bool Bit(size_type index) const noexcept {
+        return (Limb(index / limb_bits) >> (index % limb_bits)) & 1;
+    }
+
+    void SetBit(size_type index) {
+        if (limbs_.size() <= index / limb_bits)
+            limbs_.resize(index / limb_bits + 1);
+
+        limbs_[index / limb_bits] |= limb_type{1} << (index % limb_bits);
+    }
+
+public:
+    static int Compare(const BigInt& a, const BigInt& b) noexcept {
+        if (a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+
+        for (size_type i{a.size()}; i-- > 0;)
+            if (a.limbs_[i] != b.limbs_[i])
+                return a.limbs_[i] < b.limbs_[i] ? -1 : 1;
+
+        return 0;
+    }
+
+    friend bool operator==(const BigInt& a, const BigInt& b) noexcept { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const BigInt& a, const BigInt& b) noexcept { return a.limbs_ != b.limbs_; }
+    friend bool operator<(const BigInt& a, const BigInt& b) noexcept { return Compare(a, b) < 0; }
+    friend bool operator<=(const BigInt& a, const BigInt& b) noexcept { return Compare(a, b) <= 0; }
+    friend bool operator>(const BigInt& a, const BigInt& b) noexcept { return Compare(a, b) > 0; }
+    friend bool operator>=(const BigInt& a, const BigInt& b) noexcept { return Compare(a, b) >= 0; }
+
+public:
+    BigInt& operator+=(const BigInt& other) {
+        if (limbs_.size() < other.size())
+            limbs_.resize(other.size());
+
+        limb_type carry{};
+        for (size_type i{}; i < limbs_.size(); ++i) {
+            wide_type sum{static_cast<wide_type>(limbs_[i]) + other.Limb(i) + carry};
+            limbs_[i] = static_cast<limb_type>(sum);
+            carry = static_cast<limb_type>(sum >> limb_bits);
+        }
+
+        if (carry)
+            limbs_.push_back(carry);
+
+        return *this;
+    }
+
+    /*
+        Requires *this >= other.
+    */
+    BigInt& operator-=(const BigInt& other) {
+        if (*this < other)
+            throw std::invalid_argument("BigInt subtraction would be negative");
+
+        limb_type borrow{};
+        for (size_type i{}; i < limbs_.size(); ++i) {
+            limb_type subtrahend{other.Limb(i)};
+            limb_type difference{limbs_[i] - subtrahend - borrow};
+            borrow = (limbs_[i] < subtrahend || (limbs_[i] == subtrahend && borrow)) ? 1 : 0;
+            limbs_[i] = difference;
+        }
+
+        Normalize();
+
+        return *this;
+    }
+
+    BigInt& operator*=(const BigInt& other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    BigInt& operator/=(const BigInt& other) {
+        *this = DivMod(*this, other).first;
+        return *this;
+    }
+
+    BigInt& operator%=(const BigInt& other) {
+        *this = DivMod(*this, other).second;
+        return *this;
+    }
+
+    BigInt& operator<<=(size_type shift) {
+        if (IsZero() || !shift)
+            return *this;
+
+        size_type limb_shift{shift / limb_bits};
+        unsigned bit_shift{static_cast<unsigned>(shift % limb_bits)};
+
+        limbs_.insert(limbs_.begin(), limb_shift, 0);
+
+        if (bit_shift) {
+            limbs_.push_back(0);
+
+            for (size_type i{limbs_.size() - 1}; i > limb_shift; --i)
+                limbs_[i] = (limbs_[i] << bit_shift) | (limbs_[i - 1] >> (limb_bits - bit_shift));
+
+            limbs_[limb_shift] <<= bit_shift;
+        }
+
+        Normalize();
+
+        return *this;
+    }
+
+    BigInt& operator>>=(size_type shift) {
+        size_type limb_shift{shift / limb_bits};
+        unsigned bit_shift{static_cast<unsigned>(shift % limb_bits)};
+
+        if (limb_shift >= limbs_.size()) {
+            limbs_.clear();
+            return *this;
+        }
+
+        limbs_.erase(limbs_.begin(), limbs_.begin() + static_cast<std::ptrdiff_t>(limb_shift));
+
+        if (bit_shift) {
+            for (size_type i{}; i + 1 < limbs_.size(); ++i)
+                limbs_[i] = (limbs_[i] >> bit_shift) | (limbs_[i + 1] << (limb_bits - bit_shift));
+
+            limbs_.back() >>= bit_shift;
+        }
+
+        Normalize();
+
+        return *this;
+    }
+
+    friend BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+    friend BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+    friend BigInt operator/(const BigInt& a, const BigInt& b) { return DivMod(a, b).first; }
+    friend BigInt operator%(const BigInt& a, const BigInt& b) { return DivMod(a, b).second; }
+    friend BigInt operator<<(BigInt a, size_type shift) { return a <<= shift; }
+    friend BigInt operator>>(BigInt a, size_type shift) { return a >>= shift; }
+
+    friend BigInt operator*(const BigInt& a, const BigInt& b) {
+        if (a.IsZero() || b.IsZero())
+            return BigInt{};
+
+        limbs_type product(a.size() + b.size());
+
+        for (size_type i{}; i < a.size(); ++i) {
+            limb_type carry{};
+
+            for (size_type j{}; j < b.size(); ++j) {
+                wide_type t{static_cast<wide_type>(a.limbs_[i]) * b.limbs_[j] + product[i + j] + carry};
+                product[i + j] = static_cast<limb_type>(t);
+                carry = static_cast<limb_type>(t >> limb_bits);
+            }
+
+            product[i + b.size()] = carry;
+        }
+
+        return BigInt(std::move(product));
+    }
+
+public:
+    /*
+        Schoolbook long division (Knuth, TAOCP vol. 2, 4.3.1 algorithm D).
+    */
+    static std::pair<BigInt, BigInt> DivMod(const BigInt& a, const BigInt& b) {
+        if (b.IsZero())
+            throw std::domain_error("BigInt division by zero");
+
+        if (a < b)
+            return {BigInt{}, a};
+
+        if (b.size() == 1) {
+            BigInt quotient{a};
+            limb_type remainder{quotient.DivSmall(b.limbs_[0])};
+            return {std::move(quotient), BigInt{remainder}};
+        }
+
+        size_type n{b.size()};
+        size_type m{a.size() - n};
+        unsigned shift{static_cast<unsigned>(__builtin_clzll(b.limbs_.back()))};
+
+        limbs_type v(n), u(a.size() + 1), q(m + 1);
+
+        for (size_type i{n - 1}; i > 0; --i)
+            v[i] = (b.limbs_[i] << shift) | (shift ? b.limbs_[i - 1] >> (limb_bits - shift) : 0);
+        v[0] = b.limbs_[0] << shift;
+
+        u[a.size()] = shift ? a.limbs_.back() >> (limb_bits - shift) : 0;
+        for (size_type i{a.size() - 1}; i > 0; --i)
+            u[i] = (a.limbs_[i] << shift) | (shift ? a.limbs_[i - 1] >> (limb_bits - shift) : 0);
+        u[0] = a.limbs_[0] << shift;
+
+        for (size_type j{m + 1}; j-- > 0;) {
+            wide_type numerator{(static_cast<wide_type>(u[j + n]) << limb_bits) | u[j + n - 1]};
+            wide_type q_hat{numerator / v[n - 1]};
+            wide_type r_hat{numerator % v[n - 1]};
+
+            while ((q_hat >> limb_bits) || q_hat * v[n - 2] > ((r_hat << limb_bits) | u[j + n - 2])) {
+                --q_hat;
+                r_hat += v[n - 1];
+
+                if (r_hat >> limb_bits)
+                    break;
+            }
+
+            __int128 borrow{};
+            for (size_type i{}; i < n; ++i) {
+                wide_type product{q_hat * v[i]};
+                __int128 t{static_cast<__int128>(u[i + j]) - borrow - static_cast<__int128>(static_cast<limb_type>(product))};
+                u[i + j] = static_cast<limb_type>(t);
+                borrow = static_cast<__int128>(product >> limb_bits) - (t >> limb_bits);
+            }
+
+            __int128 t{static_cast<__int128>(u[j + n]) - borrow};
+            u[j + n] = static_cast<limb_type>(t);
+            q[j] = static_cast<limb_type>(q_hat);
+
+            if (t < 0) {
+                --q[j];
+
+                limb_type carry{};
+                for (size_type i{}; i < n; ++i) {
+                    wide_type sum{static_cast<wide_type>(u[i + j]) + v[i] + carry};
+                    u[i + j] = static_cast<limb_type>(sum);
+                    carry = static_cast<limb_type>(sum >> limb_bits);
+                }
+
+                u[j + n] += carry;
+            }
+        }
+
+        limbs_type r(n);
+        for (size_type i{}; i < n; ++i)
+            r[i] = (u[i] >> shift) | (shift ? u[i + 1] << (limb_bits - shift) : 0);
+
+        return {BigInt(std::move(q)), BigInt(std::move(r))};
+    }
+
+    /*
+        In-place division by a single limb, returns the remainder.
+    */
+    limb_type DivSmall(limb_type divisor) {
+        if (!divisor)
+            throw std::domain_error("BigInt division by zero");
+
+        wide_type remainder{};
+        for (size_type i{limbs_.size()}; i-- > 0;) {
+            wide_type current{(remainder << limb_bits) | limbs_[i]};
+            limbs_[i] = static_cast<limb_type>(current / divisor);
+            remainder = current % divisor;
+        }
+
+        Normalize();
+
+        return static_cast<limb_type>(remainder);
+    }
+
+    limb_type ModSmall(limb_type divisor) const {
+        if (!divisor)
+            throw std::domain_error("BigInt division by zero");
+
+        wide_type remainder{};
+        for (size_type i{limbs_.size()}; i-- > 0;)
+            remainder = ((remainder << limb_bits) | limbs_[i]) % divisor;
+
+        return static_cast<limb_type>(remainder);
+    }
+
+    /*
+        a^-1 mod m by the extended Euclidean algorithm, with the Bezout
+        coefficient kept reduced mod m so everything stays non-negative.
+    */
+    static BigInt ModInverse(const BigInt& a, const BigInt& m) {
+        BigInt r0{m}, r1{a % m};
+        BigInt t0{}, t1{1};
+
+        while (!r1.IsZero()) {
+            auto [q, r]{DivMod(r0, r1)};
+            BigInt qt{(q * t1) % m};
+            BigInt t2{t0 >= qt ? t0 - qt : t0 + (m - qt)};
+
+            r0 = std::move(r1);
+            r1 = std::move(r);
+            t0 = std::move(t1);
+            t1 = std::move(t2);
+        }
+
+        if (r0 != BigInt{1})
+            throw std::invalid_argument("Value is not invertible modulo m");
+
+        return t0;
+    }
+
+private:
+    /*
+        *this = *this * factor + addend.
+    */
+    void MulAddSmall(limb_type factor, limb_type addend) {
+        limb_type carry{addend};
+
+        for (auto& limb : limbs_) {
+            wide_type t{static_cast<wide_type>(limb) * factor + carry};
+            limb = static_cast<limb_type>(t);
+            carry = static_cast<limb_type>(t >> limb_bits);
+        }
+
+        if (carry)
+            limbs_.push_back(carry);
+    }
+
+    static constexpr limb_type Power10(size_type digits) noexcept {
+        limb_type result{1};
+
+        for (size_type i{}; i < digits; ++i)
+            result *= 10;
+
+        return result;
+    }
+
+    void Normalize() noexcept {
+        while (!limbs_.empty() && !limbs_.back())
+            limbs_.pop_back();
+    }
+
+private:
+    static constexpr const limb_type decimal_chunk_{10000000000000000000ULL};
+    static constexpr const size_type decimal_chunk_digits_{19};
+
+    limbs_type limbs_;
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_BIGINT_HPP
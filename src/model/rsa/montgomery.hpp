@@ -0,0 +1,283 @@
+#ifndef CRYPTO_MODEL_RSA_MONTGOMERY_HPP
+#define CRYPTO_MODEL_RSA_MONTGOMERY_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include "bigint.hpp"
+
+namespace s21 {
+/*
+    Arithmetic modulo a fixed odd n in Montgomery form (x -> xR mod n,
+    R = 2^(64k) for a k-limb modulus), so reductions need no division.
+    Multiplication is CIOS (word-interleaved multiply and reduce),
+    squaring computes each cross product once and reduces afterwards.
+*/
+class Montgomery {
+public:
+    using limb_type = BigInt::limb_type;
+    using wide_type = BigInt::wide_type;
+    using size_type = BigInt::size_type;
+
+public:
+    explicit Montgomery(const BigInt& modulus) :
+        modulus_(modulus),
+        size_(modulus.size()),
+        n_(modulus.Limbs())
+    {
+        if (!modulus.IsOdd() || modulus == BigInt{1})
+            throw std::invalid_argument("Montgomery modulus must be odd and greater than 1");
+
+        limb_type inverse{n_[0]};
+        for (int i{}; i < 5; ++i)
+            inverse *= 2 - n_[0] * inverse;
+
+        n0_inv_ = ~inverse + 1;
+
+        BigInt r2{BigInt{1} << (2 * size_ * BigInt::limb_bits)};
+        r2 %= modulus_;
+        r2_ = ToLimbs(r2);
+
+        BigInt one{BigInt{1} << (size_ * BigInt::limb_bits)};
+        one %= modulus_;
+        one_ = ToLimbs(one);
+    }
+
+    ~Montgomery() = default;
+
+public:
+    const BigInt& Modulus() const noexcept { return modulus_; }
+
+    size_type size() const noexcept { return size_; }
+
+    /*
+        base^exponent mod n with a sliding window over the exponent bits:
+        one squaring per bit and one multiplication per window of up to
+        WindowBits() bits, using the precomputed odd powers of the base.
+    */
+    BigInt Pow(const BigInt& base, const BigInt& exponent) const {
+        std::vector<limb_type> scratch(2 * size_ + 2);
+        std::vector<limb_type> accumulator(one_);
+
+        std::size_t bits{exponent.BitLength()};
+        unsigned window{WindowBits(bits)};
+
+        std::vector<limb_type> powers((size_type{1} << (window - 1)) * size_);
+        std::vector<limb_type> square(size_);
+
+        limb_type* first{powers.data()};
+        std::vector<limb_type> plain{ToLimbs(base < modulus_ ? base : base % modulus_)};
+        Multiply(plain.data(), r2_.data(), first, scratch.data());
+
+        Square(first, square.data(), scratch.data());
+        for (size_type i{1}; i < (size_type{1} << (window - 1)); ++i)
+            Multiply(first + (i - 1) * size_, square.data(), first + i * size_, scratch.data());
+
+        for (std::size_t i{bits}; i-- > 0;) {
+            if (!exponent.Bit(i)) {
+                Square(accumulator.data(), accumulator.data(), scratch.data());
+                continue;
+            }
+
+            std::size_t low{i + 1 >= window ? i + 1 - window : 0};
+            while (!exponent.Bit(low))
+                ++low;
+
+            size_type value{};
+            for (std::size_t j{i + 1}; j-- > low;) {
+                value = (value << 1) | exponent.Bit(j);
+                Square(accumulator.data(), accumulator.data(), scratch.data());
+            }
+
+            Multiply(accumulator.data(), first + (value >> 1) * size_, accumulator.data(), scratch.data());
+            i = low;
+        }
+
+        return FromMontgomery(accumulator.data(), scratch.data());
+    }
+
+public:
+    /*
+        out = a * b / R mod n; all operands have size() limbs and are < n.
+        out may alias a or b, scratch needs size() + 2 limbs.
+    */
+    void Multiply(const limb_type* a, const limb_type* b, limb_type* out, limb_type* scratch) const noexcept {
+        limb_type* t{scratch};
+        std::fill(t, t + size_ + 2, 0);
+
+        for (size_type i{}; i < size_; ++i) {
+            limb_type carry{};
+            for (size_type j{}; j < size_; ++j) {
+                wide_type s{static_cast<wide_type>(a[j]) * b[i] + t[j] + carry};
+                t[j] = static_cast<limb_type>(s);
+                carry = static_cast<limb_type>(s >> 64);
+            }
+
+            wide_type s{static_cast<wide_type>(t[size_]) + carry};
+            t[size_] = static_cast<limb_type>(s);
+            t[size_ + 1] = static_cast<limb_type>(s >> 64);
+
+            limb_type m{t[0] * n0_inv_};
+            s = static_cast<wide_type>(m) * n_[0] + t[0];
+            carry = static_cast<limb_type>(s >> 64);
+
+            for (size_type j{1}; j < size_; ++j) {
+                s = static_cast<wide_type>(m) * n_[j] + t[j] + carry;
+                t[j - 1] = static_cast<limb_type>(s);
+                carry = static_cast<limb_type>(s >> 64);
+            }
+
+            s = static_cast<wide_type>(t[size_]) + carry;
+            t[size_ - 1] = static_cast<limb_type>(s);
+            t[size_] = t[size_ + 1] + static_cast<limb_type>(s >> 64);
+        }
+
+        FinalSubtract(t, t[size_], out);
+    }
+
+    /*
+        out = a * a / R mod n; scratch needs 2 * size() + 1 limbs.
+    */
+    void Square(const limb_type* a, limb_type* out, limb_type* scratch) const noexcept {
+        limb_type* t{scratch};
+        std::fill(t, t + 2 * size_ + 1, 0);
+
+        for (size_type i{}; i < size_; ++i) {
+            limb_type carry{};
+            for (size_type j{i + 1}; j < size_; ++j) {
+                wide_type s{static_cast<wide_type>(a[i]) * a[j] + t[i + j] + carry};
+                t[i + j] = static_cast<limb_type>(s);
+                carry = static_cast<limb_type>(s >> 64);
+            }
+
+            t[i + size_] = carry;
+        }
+
+        for (size_type i{2 * size_}; i-- > 1;)
+            t[i] = (t[i] << 1) | (t[i - 1] >> 63);
+        t[0] <<= 1;
+
+        limb_type carry{};
+        for (size_type i{}; i < size_; ++i) {
+            wide_type square{static_cast<wide_type>(a[i]) * a[i]};
+            wide_type s{static_cast<wide_type>(t[2 * i]) + static_cast<limb_type>(square) + carry};
+            t[2 * i] = static_cast<limb_type>(s);
+            s = static_cast<wide_type>(t[2 * i + 1]) + static_cast<limb_type>(square >> 64) + static_cast<limb_type>(s >> 64);
+            t[2 * i + 1] = static_cast<limb_type>(s);
+            carry = static_cast<limb_type>(s >> 64);
+        }
+
+        Reduce(t, out);
+    }
+
+    std::vector<limb_type> ToMontgomery(const BigInt& value) const {
+        std::vector<limb_type> scratch(size_ + 2);
+        std::vector<limb_type> result{ToLimbs(value < modulus_ ? value : value % modulus_)};
+
+        Multiply(result.data(), r2_.data(), result.data(), scratch.data());
+
+        return result;
+    }
+
+    BigInt FromMontgomery(const limb_type* value, limb_type* scratch) const {
+        std::vector<limb_type> one(size_), result(size_);
+        one[0] = 1;
+
+        Multiply(value, one.data(), result.data(), scratch);
+
+        return BigInt(std::move(result));
+    }
+
+    /*
+        Zero-extended to size() limbs; value must be < n.
+    */
+    std::vector<limb_type> ToLimbs(const BigInt& value) const {
+        std::vector<limb_type> result(size_);
+        std::copy(value.Limbs().begin(), value.Limbs().end(), result.begin());
+
+        return result;
+    }
+
+private:
+    /*
+        Montgomery reduction of the 2 * size() limb product in t (t[2k] is
+        a spare carry limb): out = t / R mod n.
+    */
+    void Reduce(limb_type* t, limb_type* out) const noexcept {
+        for (size_type i{}; i < size_; ++i) {
+            limb_type m{t[i] * n0_inv_};
+            limb_type carry{};
+
+            for (size_type j{}; j < size_; ++j) {
+                wide_type s{static_cast<wide_type>(m) * n_[j] + t[i + j] + carry};
+                t[i + j] = static_cast<limb_type>(s);
+                carry = static_cast<limb_type>(s >> 64);
+            }
+
+            for (size_type p{i + size_}; carry && p <= 2 * size_; ++p) {
+                wide_type s{static_cast<wide_type>(t[p]) + carry};
+                t[p] = static_cast<limb_type>(s);
+                carry = static_cast<limb_type>(s >> 64);
+            }
+        }
+
+        FinalSubtract(t + size_, t[2 * size_], out);
+    }
+
+    /*
+        out = t - n if (top, t) >= n else t; the input is below 2n.
+    */
+    void FinalSubtract(const limb_type* t, limb_type top, limb_type* out) const noexcept {
+        bool is_greater{top != 0};
+
+        if (!is_greater) {
+            is_greater = true;
+
+            for (size_type i{size_}; i-- > 0;) {
+                if (t[i] != n_[i]) {
+                    is_greater = t[i] > n_[i];
+                    break;
+                }
+            }
+        }
+
+        if (!is_greater) {
+            std::copy(t, t + size_, out);
+            return;
+        }
+
+        limb_type borrow{};
+        for (size_type i{}; i < size_; ++i) {
+            limb_type difference{t[i] - n_[i] - borrow};
+            borrow = (t[i] < n_[i] || (t[i] == n_[i] && borrow)) ? 1 : 0;
+            out[i] = difference;
+        }
+    }
+
+    static unsigned WindowBits(std::size_t exponent_bits) noexcept {
+        if (exponent_bits > 671)
+            return 6;
+
+        if (exponent_bits > 239)
+            return 5;
+
+        if (exponent_bits > 79)
+            return 4;
+
+        return exponent_bits > 23 ? 3 : 1;
+    }
+
+private:
+    BigInt modulus_;
+    size_type size_{};
+    std::vector<limb_type> n_;
+    limb_type n0_inv_{};
+    std::vector<limb_type> r2_;
+    std::vector<limb_type> one_;
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_MONTGOMERY_HPP
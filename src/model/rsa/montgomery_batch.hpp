@@ -0,0 +1,394 @@
+#ifndef CRYPTO_MODEL_RSA_MONTGOMERY_BATCH_HPP
+#define CRYPTO_MODEL_RSA_MONTGOMERY_BATCH_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "bigint.hpp"
+#include "montgomery.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRYPTO_RSA_HAS_SIMD_PATH 1
+#include <immintrin.h>
+#else
+#define CRYPTO_RSA_HAS_SIMD_PATH 0
+#endif
+
+namespace s21 {
+enum class MontgomeryBackend : uint8_t { kAuto, kScalar, kAVX2, kIFMA };
+
+/*
+    Exponentiation of many bases under one (exponent, modulus), several at
+    a time in the lanes of a vector register. Limb j of all the bases in a
+    pass shares one register, and the lanes share the exponent, so
+    squarings and window multiplications run in lockstep with no per-lane
+    branching. Two kernels:
+        - AVX-512 IFMA: eight lanes of 52-bit limbs, limb products from
+          vpmadd52luq/vpmadd52huq;
+        - AVX2: four lanes of 26-bit limbs, limb products from vpmuludq
+          (32 x 32 -> 64). Column sums are only carried once per row, which
+          26-bit products leave room for up to far beyond RSA sizes.
+
+    The lanes use almost-Montgomery multiplication with R = 2^(wk), 4n < R:
+    operands and results stay below 2n and only the final conversion
+    subtracts n. Without either extension every base goes through the
+    scalar Montgomery::Pow.
+*/
+class MontgomeryBatch {
+public:
+    using limb_type = uint64_t;
+    using size_type = std::size_t;
+
+public:
+    /*
+        Most bases per pass (the IFMA kernel).
+    */
+    static constexpr const size_type lanes{8};
+
+public:
+    explicit MontgomeryBatch(const BigInt& modulus) :
+        scalar_(modulus),
+        ifma_(MakeForm(modulus, ifma_limb_bits_)),
+        avx2_(MakeForm(modulus, avx2_limb_bits_))
+    {}
+
+    ~MontgomeryBatch() = default;
+
+public:
+    static bool HasAVX2() noexcept {
+#if CRYPTO_RSA_HAS_SIMD_PATH
+        static const bool has_avx2{__builtin_cpu_supports("avx2") != 0};
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    static bool HasIFMA() noexcept {
+#if CRYPTO_RSA_HAS_SIMD_PATH
+        static const bool has_ifma{__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma")};
+        return has_ifma;
+#else
+        return false;
+#endif
+    }
+
+    /*
+        kAuto picks the widest kernel the CPU supports.
+    */
+    static MontgomeryBackend Resolve(MontgomeryBackend backend) noexcept {
+        if (backend == MontgomeryBackend::kAuto)
+            backend = MontgomeryBackend::kIFMA;
+
+        if (backend == MontgomeryBackend::kIFMA && !HasIFMA())
+            backend = MontgomeryBackend::kAVX2;
+
+        if (backend == MontgomeryBackend::kAVX2 && !HasAVX2())
+            backend = MontgomeryBackend::kScalar;
+
+        return backend;
+    }
+
+    const BigInt& Modulus() const noexcept { return scalar_.Modulus(); }
+
+    BigInt Pow(const BigInt& base, const BigInt& exponent) const {
+        return scalar_.Pow(base, exponent);
+    }
+
+    /*
+        values[i] = values[i]^exponent mod n for i < count, in place.
+    */
+    void Pow(BigInt* values, size_type count, const BigInt& exponent, MontgomeryBackend backend = MontgomeryBackend::kAuto) const {
+        if (count > 1 && !exponent.IsZero()) {
+            switch (Resolve(backend)) {
+#if CRYPTO_RSA_HAS_SIMD_PATH
+                case MontgomeryBackend::kIFMA:
+                    for (size_type i{}; i < count; i += ifma_lanes_)
+                        PowLanes<ifma_lanes_>(values + i, std::min(ifma_lanes_, count - i), exponent, ifma_,
+                            [this](const limb_type* a, const limb_type* b, limb_type* out, limb_type* scratch, const limb_type* n) {
+                                MultiplyIFMA(a, b, out, scratch, n);
+                            });
+                    return;
+                case MontgomeryBackend::kAVX2:
+                    for (size_type i{}; i < count; i += avx2_lanes_)
+                        PowLanes<avx2_lanes_>(values + i, std::min(avx2_lanes_, count - i), exponent, avx2_,
+                            [this](const limb_type* a, const limb_type* b, limb_type* out, limb_type* scratch, const limb_type* n) {
+                                MultiplyAVX2(a, b, out, scratch, n);
+                            });
+                    return;
+#endif
+                default:
+                    break;
+            }
+        }
+
+        for (size_type i{}; i < count; ++i)
+            values[i] = scalar_.Pow(values[i], exponent);
+    }
+
+private:
+    /*
+        The modulus and R^2 mod n split into limbs of one kernel's width,
+        and k0 = -n^-1 mod 2^limb_bits.
+    */
+    struct LimbForm {
+        unsigned limb_bits{};
+        limb_type mask{};
+        size_type size{};
+        std::vector<limb_type> n;
+        std::vector<limb_type> r2;
+        limb_type k0{};
+    };
+
+    static LimbForm MakeForm(const BigInt& modulus, unsigned limb_bits) {
+        LimbForm form;
+        form.limb_bits = limb_bits;
+        form.mask = (limb_type{1} << limb_bits) - 1;
+        form.size = (modulus.BitLength() + 2 + limb_bits - 1) / limb_bits;
+        form.n = ToLimbs(modulus, form.size, limb_bits);
+        form.r2 = ToLimbs((BigInt{1} << (2 * limb_bits * form.size)) % modulus, form.size, limb_bits);
+
+        limb_type inverse{form.n[0]};
+        for (int i{}; i < 5; ++i)
+            inverse *= 2 - form.n[0] * inverse;
+
+        form.k0 = (~inverse + 1) & form.mask;
+
+        return form;
+    }
+
+    /*
+        Fixed windows: every lane multiplies by the same table entry.
+        Buffers hold form.size limbs of all lanes, limb j at [j * Lanes];
+        multiply(a, b, out, scratch, n) is the kernel's Montgomery product.
+    */
+    template <size_type Lanes, typename Multiply>
+    void PowLanes(BigInt* values, size_type count, const BigInt& exponent, const LimbForm& form, Multiply multiply) const {
+        size_type width{form.size * Lanes};
+        size_type bits{exponent.BitLength()};
+        unsigned window{WindowBits(bits)};
+
+        std::vector<limb_type> n(width), r2(width), one(width), plain(width);
+        std::vector<limb_type> table((size_type{1} << window) * width), accumulator(width), scratch(2 * width);
+
+        for (size_type j{}; j < form.size; ++j) {
+            std::fill(n.begin() + j * Lanes, n.begin() + (j + 1) * Lanes, form.n[j]);
+            std::fill(r2.begin() + j * Lanes, r2.begin() + (j + 1) * Lanes, form.r2[j]);
+        }
+
+        std::fill(one.begin(), one.begin() + Lanes, 1);
+
+        for (size_type lane{}; lane < count; ++lane) {
+            std::vector<limb_type> limbs{ToLimbs(values[lane] < Modulus() ? values[lane] : values[lane] % Modulus(), form.size, form.limb_bits)};
+
+            for (size_type j{}; j < form.size; ++j)
+                plain[j * Lanes + lane] = limbs[j];
+        }
+
+        multiply(r2.data(), one.data(), table.data(), scratch.data(), n.data());
+        multiply(plain.data(), r2.data(), table.data() + width, scratch.data(), n.data());
+
+        for (size_type i{2}; i < (size_type{1} << window); ++i)
+            multiply(table.data() + (i - 1) * width, table.data() + width, table.data() + i * width, scratch.data(), n.data());
+
+        size_type position{(bits - 1) / window * window};
+        size_type entry{Window(exponent, position, window)};
+        std::copy(table.begin() + entry * width, table.begin() + (entry + 1) * width, accumulator.begin());
+
+        while (position) {
+            position -= window;
+
+            for (unsigned i{}; i < window; ++i)
+                multiply(accumulator.data(), accumulator.data(), accumulator.data(), scratch.data(), n.data());
+
+            if ((entry = Window(exponent, position, window)))
+                multiply(accumulator.data(), table.data() + entry * width, accumulator.data(), scratch.data(), n.data());
+        }
+
+        multiply(accumulator.data(), one.data(), accumulator.data(), scratch.data(), n.data());
+
+        for (size_type lane{}; lane < count; ++lane) {
+            std::vector<limb_type> limbs(form.size);
+
+            for (size_type j{}; j < form.size; ++j)
+                limbs[j] = accumulator[j * Lanes + lane];
+
+            values[lane] = FromLimbs(limbs, form.limb_bits);
+            if (values[lane] >= Modulus())
+                values[lane] -= Modulus();
+        }
+    }
+
+#if CRYPTO_RSA_HAS_SIMD_PATH
+    /*
+        out = a * b / R mod n (below 2n) in every lane; out may alias a or
+        b, scratch needs 2 * size limbs per lane. Row i adds a_i * b and
+        m * n to columns i.., the high halves and the carry out of column
+        i riding along into the next column in a register.
+    */
+    __attribute__((target("avx512f,avx512ifma")))
+    void MultiplyIFMA(const limb_type* a, const limb_type* b, limb_type* out, limb_type* scratch, const limb_type* n) const noexcept {
+        constexpr size_type lanes{ifma_lanes_};
+        const size_type size{ifma_.size};
+        const __m512i zero{_mm512_setzero_si512()};
+        const __m512i mask{_mm512_set1_epi64(static_cast<long long>(ifma_.mask))};
+        const __m512i k0{_mm512_set1_epi64(static_cast<long long>(ifma_.k0))};
+
+        std::fill(scratch, scratch + 2 * size * lanes, 0);
+
+        for (size_type i{}; i < size; ++i) {
+            __m512i a_i{_mm512_loadu_si512(a + i * lanes)};
+            __m512i b_0{_mm512_loadu_si512(b)};
+            __m512i n_0{_mm512_loadu_si512(n)};
+
+            __m512i column{_mm512_madd52lo_epu64(_mm512_loadu_si512(scratch + i * lanes), a_i, b_0)};
+            __m512i m{_mm512_madd52lo_epu64(zero, column, k0)};
+            column = _mm512_madd52lo_epu64(column, m, n_0);
+
+            __m512i high{reinterpret_cast<__m512i>(reinterpret_cast<word512>(column) >> ifma_limb_bits_)};
+            high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(high, a_i, b_0), m, n_0);
+
+            for (size_type j{1}; j < size; ++j) {
+                __m512i b_j{_mm512_loadu_si512(b + j * lanes)};
+                __m512i n_j{_mm512_loadu_si512(n + j * lanes)};
+                limb_type* t{scratch + (i + j) * lanes};
+
+                column = _mm512_add_epi64(_mm512_loadu_si512(t), high);
+                column = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(column, a_i, b_j), m, n_j);
+                _mm512_storeu_si512(t, column);
+
+                high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, a_i, b_j), m, n_j);
+            }
+
+            limb_type* t{scratch + (i + size) * lanes};
+            _mm512_storeu_si512(t, _mm512_add_epi64(_mm512_loadu_si512(t), high));
+        }
+
+        __m512i carry{zero};
+        for (size_type j{}; j < size; ++j) {
+            __m512i value{_mm512_add_epi64(_mm512_loadu_si512(scratch + (size + j) * lanes), carry)};
+            _mm512_storeu_si512(out + j * lanes, _mm512_and_si512(value, mask));
+            carry = reinterpret_cast<__m512i>(reinterpret_cast<word512>(value) >> ifma_limb_bits_);
+        }
+    }
+
+    /*
+        Same contract as MultiplyIFMA, on 26-bit limbs. vpmuludq gives the
+        full 52-bit product, so the columns simply accumulate: a column
+        gets at most 2 * size products below 2^52 before it is read, and
+        only the lowest one is carried per row, once m * n has cleared its
+        low 26 bits.
+    */
+    __attribute__((target("avx2")))
+    void MultiplyAVX2(const limb_type* a, const limb_type* b, limb_type* out, limb_type* scratch, const limb_type* n) const noexcept {
+        constexpr size_type lanes{avx2_lanes_};
+        const size_type size{avx2_.size};
+        const __m256i mask{_mm256_set1_epi64x(static_cast<long long>(avx2_.mask))};
+        const __m256i k0{_mm256_set1_epi64x(static_cast<long long>(avx2_.k0))};
+
+        std::fill(scratch, scratch + 2 * size * lanes, 0);
+
+        for (size_type i{}; i < size; ++i) {
+            __m256i a_i{Load256(a + i * lanes)};
+
+            __m256i column{_mm256_add_epi64(Load256(scratch + i * lanes), _mm256_mul_epu32(a_i, Load256(b)))};
+            __m256i m{_mm256_and_si256(_mm256_mul_epu32(column, k0), mask)};
+            column = _mm256_add_epi64(column, _mm256_mul_epu32(m, Load256(n)));
+
+            limb_type* next{scratch + (i + 1) * lanes};
+            Store256(next, _mm256_add_epi64(Load256(next), _mm256_srli_epi64(column, avx2_limb_bits_)));
+
+            for (size_type j{1}; j < size; ++j) {
+                limb_type* t{scratch + (i + j) * lanes};
+                __m256i products{_mm256_add_epi64(_mm256_mul_epu32(a_i, Load256(b + j * lanes)), _mm256_mul_epu32(m, Load256(n + j * lanes)))};
+                Store256(t, _mm256_add_epi64(Load256(t), products));
+            }
+        }
+
+        __m256i carry{_mm256_setzero_si256()};
+        for (size_type j{}; j < size; ++j) {
+            __m256i value{_mm256_add_epi64(Load256(scratch + (size + j) * lanes), carry)};
+            Store256(out + j * lanes, _mm256_and_si256(value, mask));
+            carry = _mm256_srli_epi64(value, avx2_limb_bits_);
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i Load256(const limb_type* data) noexcept {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    }
+
+    __attribute__((target("avx2")))
+    static void Store256(limb_type* data, __m256i value) noexcept {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+    }
+#endif
+
+    static size_type Window(const BigInt& exponent, size_type position, unsigned window) noexcept {
+        size_type value{};
+        for (unsigned i{window}; i-- > 0;)
+            value = (value << 1) | exponent.Bit(position + i);
+
+        return value;
+    }
+
+    static unsigned WindowBits(size_type bits) noexcept {
+        if (bits <= 32)
+            return 1;
+        if (bits <= 256)
+            return 3;
+        if (bits <= 768)
+            return 4;
+        return 5;
+    }
+
+    static std::vector<limb_type> ToLimbs(const BigInt& value, size_type size, unsigned limb_bits) {
+        std::vector<limb_type> limbs(size);
+        limb_type mask{(limb_type{1} << limb_bits) - 1};
+
+        for (size_type i{}; i < size; ++i) {
+            size_type bit{i * limb_bits};
+            size_type index{bit / BigInt::limb_bits}, shift{bit % BigInt::limb_bits};
+
+            limb_type limb{value.Limb(index) >> shift};
+            if (shift + limb_bits > BigInt::limb_bits)
+                limb |= value.Limb(index + 1) << (BigInt::limb_bits - shift);
+
+            limbs[i] = limb & mask;
+        }
+
+        return limbs;
+    }
+
+    static BigInt FromLimbs(const std::vector<limb_type>& limbs, unsigned limb_bits) {
+        BigInt::limbs_type result((limbs.size() * limb_bits + BigInt::limb_bits - 1) / BigInt::limb_bits);
+
+        for (size_type i{}; i < limbs.size(); ++i) {
+            size_type bit{i * limb_bits};
+            size_type index{bit / BigInt::limb_bits}, shift{bit % BigInt::limb_bits};
+
+            result[index] |= limbs[i] << shift;
+            if (shift + limb_bits > BigInt::limb_bits)
+                result[index + 1] |= limbs[i] >> (BigInt::limb_bits - shift);
+        }
+
+        return BigInt{result};
+    }
+
+private:
+    typedef uint64_t word512 __attribute__((vector_size(64)));
+
+    static constexpr const size_type ifma_lanes_{lanes};
+    static constexpr const size_type avx2_lanes_{4};
+    static constexpr const unsigned ifma_limb_bits_{52};
+    static constexpr const unsigned avx2_limb_bits_{26};
+
+    Montgomery scalar_;
+    LimbForm ifma_;
+    LimbForm avx2_;
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_MONTGOMERY_BATCH_HPP
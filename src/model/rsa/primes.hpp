@@ -0,0 +1,201 @@
+#ifndef CRYPTO_MODEL_RSA_PRIMES_HPP
+#define CRYPTO_MODEL_RSA_PRIMES_HPP
+
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+
+#include "bigint.hpp"
+#include "parallel.hpp"
+#include "montgomery.hpp"
+
+namespace s21 {
+/*
+    Probable-prime testing and random prime generation for RSA keys.
+    Candidates come in sieve windows: a random odd start and the odd
+    numbers after it, with every multiple of a small prime struck out
+    before any Miller-Rabin round is spent on it.
+*/
+class Primes {
+public:
+    using size_type = std::size_t;
+
+    struct AcceptAny {
+        bool operator()(const BigInt&) const noexcept { return true; }
+    };
+
+public:
+    /*
+        Miller-Rabin with random bases; the round counts are those FIPS
+        186-4 (table C.2) gives for random candidates of that size.
+    */
+    template <typename Engine>
+    static bool IsProbablePrime(const BigInt& n, Engine& engine) {
+        if (n < BigInt{4})
+            return n == BigInt{2} || n == BigInt{3};
+
+        if (!n.IsOdd())
+            return false;
+
+        BigInt n_minus_one{n - BigInt{1}};
+        size_type shift{};
+        while (!n_minus_one.Bit(shift))
+            ++shift;
+
+        BigInt d{n_minus_one >> shift};
+        Montgomery montgomery(n);
+
+        for (size_type round{}, rounds{Rounds(n.BitLength())}; round < rounds; ++round) {
+            BigInt base{BigInt::Random(n.BitLength() + 64, engine) % (n - BigInt{3}) + BigInt{2}};
+            BigInt x{montgomery.Pow(base, d)};
+
+            if (x == BigInt{1} || x == n_minus_one)
+                continue;
+
+            bool is_witness{true};
+            for (size_type i{1}; i < shift && is_witness; ++i) {
+                x = x * x % n;
+                is_witness = x != n_minus_one;
+            }
+
+            if (is_witness)
+                return false;
+        }
+
+        return true;
+    }
+
+    /*
+        Random prime of exactly `bits` bits with the two top bits set, so
+        the product of two such primes has exactly 2 * bits bits. Only
+        primes for which accept(prime) holds are returned.
+    */
+    template <typename Engine, typename Predicate = AcceptAny>
+    static BigInt Generate(size_type bits, Engine& engine, Predicate accept = {}) {
+        std::atomic<bool> stop{false};
+
+        while (true)
+            if (auto prime{SearchWindow(bits, engine, accept, stop)})
+                return *prime;
+    }
+
+    /*
+        The same search on `threads` threads, each with its own random
+        source and windows; the first prime found wins and stops the rest.
+    */
+    template <typename Predicate = AcceptAny>
+    static BigInt GenerateParallel(size_type bits, size_type threads, Predicate accept = {}) {
+        std::atomic<bool> stop{false};
+        std::mutex result_mutex;
+        BigInt result;
+
+        Parallel::For(0, std::max<size_type>(threads, 1), 1, threads, [&](size_type, size_type) {
+            std::random_device engine;
+
+            try {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto prime{SearchWindow(bits, engine, accept, stop)};
+
+                    if (prime && !stop.exchange(true)) {
+                        std::lock_guard<std::mutex> lock(result_mutex);
+                        result = std::move(*prime);
+                    }
+                }
+            } catch (...) {
+                stop = true;
+                throw;
+            }
+        });
+
+        return result;
+    }
+
+    /*
+        Odd primes below sieve_limit.
+    */
+    static const std::vector<uint32_t>& SmallPrimes() {
+        static const std::vector<uint32_t> primes{[] {
+            std::vector<bool> composite(sieve_limit);
+            std::vector<uint32_t> result;
+
+            for (uint32_t i{3}; i < sieve_limit; i += 2) {
+                if (composite[i])
+                    continue;
+
+                result.push_back(i);
+                for (uint32_t j{i * i}; j < sieve_limit; j += 2 * i)
+                    composite[j] = true;
+            }
+
+            return result;
+        }()};
+
+        return primes;
+    }
+
+public:
+    static constexpr const uint32_t sieve_limit{8192};
+    static constexpr const size_type sieve_window{4096};
+
+private:
+    /*
+        Candidates start + 2j, j < sieve_window. start + 2j is divisible by
+        p exactly when j = -start / 2 mod p, so every small prime strikes
+        out an arithmetic progression.
+    */
+    template <typename Engine, typename Predicate>
+    static std::optional<BigInt> SearchWindow(size_type bits, Engine& engine, Predicate& accept, const std::atomic<bool>& stop) {
+        if (bits < min_bits_)
+            throw std::invalid_argument("Prime size is too small");
+
+        BigInt start{BigInt::Random(bits, engine)};
+        start.SetBit(bits - 1);
+        start.SetBit(bits - 2);
+        start.SetBit(0);
+
+        std::vector<bool> composite(sieve_window);
+
+        for (uint32_t prime : SmallPrimes()) {
+            uint64_t residue{start.ModSmall(prime)};
+            uint64_t j{(prime - residue) % prime * ((prime + 1) / 2) % prime};
+
+            for (; j < sieve_window; j += prime)
+                composite[j] = true;
+        }
+
+        for (size_type j{}; j < sieve_window && !stop.load(std::memory_order_relaxed); ++j) {
+            if (composite[j])
+                continue;
+
+            BigInt candidate{start + BigInt{2 * j}};
+            if (candidate.BitLength() != bits)
+                break;
+
+            if (accept(candidate) && IsProbablePrime(candidate, engine))
+                return candidate;
+        }
+
+        return std::nullopt;
+    }
+
+    static size_type Rounds(size_type bits) noexcept {
+        if (bits >= 1024)
+            return 5;
+
+        if (bits >= 512)
+            return 8;
+
+        return bits >= 256 ? 20 : 40;
+    }
+
+private:
+    static constexpr const size_type min_bits_{16};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_PRIMES_HPP
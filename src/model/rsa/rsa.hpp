@@ -1,8 +1,26 @@
 #ifndef CRYPTO_MODEL_RSA_RSA_HPP
 #define CRYPTO_MODEL_RSA_RSA_HPP
 
-#include <memory>
+#include <array>
+#include <vector>
+#include <string>
+#include <random>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
 #include <string_view>
+#include <unordered_map>
+
+#include "bigint.hpp"
+#include "primes.hpp"
+#include "rsa_key.hpp"
+#include "parallel.hpp"
+#include "rsa_padding.hpp"
+#include "rsa_envelope.hpp"
+#include "rsa_container.hpp"
 
 #include "tools.hpp"
 
@@ -11,136 +29,472 @@ class RSA {
 private:
     using file_t = tools::filesystem::file_t;
 
+public:
+    static constexpr const std::size_t default_key_bits{2048};
+
 public:
     RSA() = default;
     ~RSA() = default;
 
 public:
-    void GenerateKeys(std::string_view dir) {
+    /*
+        Two random primes of key_bits / 2 bits each, searched for on all
+        worker threads, e = 65537 and d = e^-1 mod (p - 1)(q - 1) by the
+        extended Euclidean algorithm. The private key is written with its
+        CRT fields.
+    */
+    void GenerateKeys(std::string_view dir, std::size_t key_bits = default_key_bits) {
+        if (key_bits < min_key_bits_ || key_bits > max_key_bits_)
+            throw std::invalid_argument("RSA key size must be between " + std::to_string(min_key_bits_) +
+                                        " and " + std::to_string(max_key_bits_) + " bits");
+
         fs::path dir_fs(dir);
 
-        static constexpr const int range_min{100};
-        static constexpr const int range_max{10000};
+        BigInt e{public_exponent_};
+        BigInt p{GeneratePrime(key_bits / 2)};
+        BigInt q{GeneratePrime(key_bits - key_bits / 2)};
 
-        tools::random::generator_int<int64_t> r_generator(range_min, range_max);
+        while (q == p)
+            q = GeneratePrime(key_bits - key_bits / 2);
 
-        int64_t p{r_generator.get_random_value()};
-        int64_t q{r_generator.get_random_value()};
+        BigInt n{p * q};
+        BigInt phi{(p - BigInt{1}) * (q - BigInt{1})};
+        BigInt d{BigInt::ModInverse(e, phi)};
 
-        while (!IsPrime(p))
-            p = r_generator.get_random_value();
+        file_t public_file(dir_fs / "public_key", RSAKey{e, n, std::nullopt}.ToString());
+        file_t private_file(dir_fs / "private_key", RSAKey::MakePrivate(d, p, q).ToString());
 
-        while (!IsPrime(q) || q == p)
-            q = r_generator.get_random_value();
+        fsm_.create_file(public_file);
+        fsm_.create_file(private_file);
+    }
 
-        int64_t n{p * q};
-        int64_t phi{(p - 1) * (q - 1)};
+    /*
+        kByte turns every byte into one value m^e mod n. kBlock packs up
+        to k - 11 bytes (k the modulus size in bytes) into each PKCS #1
+        v1.5 padded block, one exponentiation per block. kBinary writes an
+        RSAContainer, kText decimal numbers (the original format in byte
+        mode, after a "S21R-BLOCK" header line in block mode).
+    */
+    void Encode(std::string_view file_path, std::string_view key_path,
+                RSAMode mode = RSAMode::kByte, RSAFormat format = RSAFormat::kBinary) {
+        RSAContext context{LoadKey(key_path)};
+        auto file{fsm_.read_file(fs::path(file_path))};
+        std::string text{file.get_text()};
 
-        tools::random::generator_int<int64_t> new_r_generator(2, phi - 1);
-        int64_t e{new_r_generator.get_random_value()};
+        std::string encoded{mode == RSAMode::kBlock ? EncodeBlocks(text, context, format) : EncodeBytes(text, context, format)};
 
-        while (std::gcd(e, phi) != 1)
-            e = new_r_generator.get_random_value();
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_encoded"), encoded));
+    }
 
-        int64_t d{};
+    /*
+        Mode and format are recognized from the file; envelopes are opened
+        as by DecodeEnvelope.
+    */
+    void Decode(std::string_view file_path, std::string_view key_path) {
+        RSAContext context{LoadKey(key_path)};
+        auto file{fsm_.read_file(fs::path(file_path))};
+        std::string text{file.get_text()};
 
-        while ((e * d) % phi != 1)
-            d++;
+        if (RSAEnvelope::IsEnvelope(text)) {
+            fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), RSAEnvelope::Open(text, context, des_)));
+            return;
+        }
 
-        std::string public_key{std::to_string(e) + " " + std::to_string(n)};
-        std::string private_key{std::to_string(d) + " " + std::to_string(n)};
+        Ciphertext ciphertext{ReadCiphertext(text, context)};
+        std::string decoded{ciphertext.header.mode == RSAMode::kBlock ? DecodeBlocks(ciphertext, context)
+                                                                      : DecodeBytes(ciphertext, context)};
 
-        file_t public_file(dir_fs / "public_key", public_key);
-        file_t private_file(dir_fs / "private_key", private_key);
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), decoded));
+    }
 
-        fsm_.create_file(public_file);
-        fsm_.create_file(private_file);
+    /*
+        Hybrid encryption (see RSAEnvelope): a random 3DES session key
+        encrypts the file, RSA only the session key.
+    */
+    void EncodeEnvelope(std::string_view file_path, std::string_view key_path) {
+        RSAContext context{LoadKey(key_path)};
+        auto file{fsm_.read_file(fs::path(file_path))};
+
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_encoded"), RSAEnvelope::Seal(file.get_text(), context, des_)));
     }
 
-    void Encode(std::string_view file_path, std::string_view key_path) {
+    void DecodeEnvelope(std::string_view file_path, std::string_view key_path) {
+        RSAContext context{LoadKey(key_path)};
         auto file{fsm_.read_file(fs::path(file_path))};
-        std::size_t size{file.size()};
 
-        std::ifstream key(fs::path(key_path), std::ios::in);
+        fsm_.create_file(file_t(GetNewFilePath(file_path, "_decoded"), RSAEnvelope::Open(file.get_text(), context, des_)));
+    }
 
-        if (key.is_open()) {
-            int64_t k_a{};
-            int64_t k_b{};
+public:
+    /*
+        Number of worker threads (hardware concurrency by default), for
+        the envelope's bulk cipher as well.
+    */
+    void SetThreads(std::size_t threads) noexcept {
+        threads_ = threads ? threads : 1;
+        des_.SetThreads(threads_);
+    }
 
-            key >> k_a >> k_b;
+    std::size_t GetThreads() const noexcept { return threads_; }
 
-            std::string filename(file_path);
-            auto pos{filename.find_last_of(".")};
-            if (pos != std::string_view::npos)
-                filename.insert(pos, "_encoded");
-            else
-                filename += "_encoded";
+private:
+    struct Ciphertext {
+        RSAHeader header;
+        RSAFormat format{RSAFormat::kBinary};
+        std::vector<std::string_view> values;
+    };
+
+    /*
+        A byte has only 256 values, so each distinct one is exponentiated
+        and formatted once per file, the distinct bytes spread over the
+        worker threads.
+    */
+    std::string EncodeBytes(std::string_view text, const RSAContext& context, RSAFormat format) {
+        if (context.Modulus() <= BigInt{byte_values_ - 1})
+            throw std::invalid_argument("RSA modulus is too small to encode bytes");
+
+        RSAHeader header;
+        header.mode = RSAMode::kByte;
+        header.key_bytes = KeyBytes(context);
+        header.length = text.size();
+        header.count = text.size();
+
+        std::array<bool, byte_values_> present{};
+        for (char c : text)
+            present[static_cast<unsigned char>(c)] = true;
+
+        std::vector<unsigned char> bytes;
+        for (std::size_t i{}; i < byte_values_; ++i)
+            if (present[i])
+                bytes.push_back(static_cast<unsigned char>(i));
+
+        std::vector<BigInt> values(bytes.begin(), bytes.end());
+        ApplyAll(context, values);
+
+        std::array<std::string, byte_values_> encoded_bytes;
+        for (std::size_t i{}; i < bytes.size(); ++i)
+            AppendValue(encoded_bytes[bytes[i]], values[i], header.key_bytes, format);
+
+        std::string encoded{FormatHeader(header, format)};
+
+        if (format == RSAFormat::kBinary)
+            encoded.reserve(encoded.size() + text.size() * header.key_bytes);
+
+        for (char c : text)
+            encoded += encoded_bytes[static_cast<unsigned char>(c)];
+
+        return encoded;
+    }
 
-            std::ofstream encoded_file(fs::path(filename), std::ios::out);
+    std::string EncodeBlocks(std::string_view text, const RSAContext& context, RSAFormat format) {
+        RSAHeader header;
+        header.mode = RSAMode::kBlock;
+        header.key_bytes = KeyBytes(context);
+        header.length = text.size();
 
-            for (std::size_t i{}; i < size; ++i)
-                encoded_file << EncryptBaseCode(static_cast<int64_t>(file[i]), k_a, k_b) << ' ';
-        }
+        std::size_t block_data{RSAPadding::MaxMessageSize(header.key_bytes)};
+        header.count = (text.size() + block_data - 1) / block_data;
+
+        std::string encoded{FormatHeader(header, format)};
+
+        encoded += ForChunks(header.count, [&](std::size_t begin, std::size_t end, std::string& out) {
+            std::random_device engine;
+            std::vector<unsigned char> block(header.key_bytes);
+            std::vector<BigInt> values;
+
+            if (format == RSAFormat::kBinary)
+                out.reserve((end - begin) * header.key_bytes);
+
+            for (std::size_t batch{begin}; batch < end; batch += batch_size_) {
+                values.clear();
+
+                for (std::size_t i{batch}; i < std::min(end, batch + batch_size_); ++i) {
+                    std::size_t offset{i * block_data};
+                    RSAPadding::Pad(text.data() + offset, std::min(block_data, text.size() - offset), block.data(), header.key_bytes, engine);
+
+                    values.push_back(BigInt::FromBytes(block.data(), header.key_bytes));
+                }
+
+                context.Apply(values.data(), values.size());
+
+                for (const BigInt& value : values)
+                    AppendValue(out, value, header.key_bytes, format);
+            }
+        });
+
+        return encoded;
     }
 
-    void Decode(std::string_view file_path, std::string_view key_path) {
-        std::ifstream file(fs::path(file_path), std::ios::in);
-        std::ifstream key(fs::path(key_path), std::ios::in);
+    /*
+        Equal ciphertext values decode to the same byte: the distinct ones
+        are collected first and decrypted in parallel.
+    */
+    std::string DecodeBytes(const Ciphertext& ciphertext, const RSAContext& context) {
+        std::unordered_map<std::string_view, std::size_t> indices;
+        std::vector<std::string_view> distinct;
+        std::vector<std::size_t> order;
+        order.reserve(ciphertext.values.size());
+
+        for (std::string_view token : ciphertext.values) {
+            auto it{indices.emplace(token, distinct.size()).first};
 
-        if (key.is_open() && file.is_open()) {
-            int64_t tmp{};
-            int64_t k_a{};
-            int64_t k_b{};
+            if (it->second == distinct.size())
+                distinct.push_back(token);
 
-            key >> k_a >> k_b;
+            order.push_back(it->second);
+        }
+
+        std::vector<BigInt> values;
+        values.reserve(distinct.size());
+
+        for (std::string_view token : distinct)
+            values.push_back(ParseValue(token, ciphertext.format, context));
 
-            std::string filename(file_path);
-            auto pos{filename.find_last_of(".")};
-            if (pos != std::string_view::npos)
-                filename.insert(pos, "_decoded");
-            else
-                filename += "_decoded";
+        ApplyAll(context, values);
 
-            std::ofstream decoded_file(fs::path(filename), std::ios::out);
+        std::vector<char> bytes(distinct.size());
+        for (std::size_t i{}; i < values.size(); ++i) {
+            if (values[i] >= BigInt{byte_values_})
+                throw std::invalid_argument("RSA value does not decode to a byte (wrong key?)");
 
-            while (file >> tmp)
-                decoded_file << static_cast<char>(EncryptBaseCode(tmp, k_a, k_b));
+            bytes[i] = static_cast<char>(values[i].Limb(0));
         }
+
+        std::string decoded;
+        decoded.reserve(order.size());
+
+        for (std::size_t index : order)
+            decoded += bytes[index];
+
+        return decoded;
+    }
+
+    std::string DecodeBlocks(const Ciphertext& ciphertext, const RSAContext& context) {
+        std::size_t key_bytes{ciphertext.header.key_bytes};
+
+        std::string decoded{ForChunks(ciphertext.values.size(), [&](std::size_t begin, std::size_t end, std::string& out) {
+            std::vector<unsigned char> block(key_bytes);
+            std::vector<BigInt> values;
+            out.reserve((end - begin) * RSAPadding::MaxMessageSize(key_bytes));
+
+            for (std::size_t batch{begin}; batch < end; batch += batch_size_) {
+                values.clear();
+
+                for (std::size_t i{batch}; i < std::min(end, batch + batch_size_); ++i)
+                    values.push_back(ParseValue(ciphertext.values[i], ciphertext.format, context));
+
+                context.Apply(values.data(), values.size());
+
+                for (const BigInt& value : values) {
+                    value.ToBytes(block.data(), key_bytes);
+                    RSAPadding::Unpad(block.data(), key_bytes, out);
+                }
+            }
+        })};
+
+        if (decoded.size() != ciphertext.header.length)
+            throw std::invalid_argument("Corrupted RSA file: length does not match header");
+
+        return decoded;
+    }
+
+    /*
+        context.Apply on every value, in lockstep batches spread over the
+        worker threads.
+    */
+    void ApplyAll(const RSAContext& context, std::vector<BigInt>& values) const {
+        Parallel::For(0, values.size(), MontgomeryBatch::lanes, threads_, [&](std::size_t begin, std::size_t end) {
+            context.Apply(values.data() + begin, end - begin);
+        });
+    }
+
+    /*
+        Splits [0, count) into one contiguous chunk per worker thread, lets
+        function(begin, end, out) fill each chunk's own buffer and joins the
+        buffers in order.
+    */
+    template <typename Function>
+    std::string ForChunks(std::size_t count, Function&& function) const {
+        std::size_t chunks{std::min(count, threads_)};
+        std::vector<std::string> outputs(chunks);
+
+        Parallel::For(0, chunks, 1, threads_, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t chunk{begin}; chunk < end; ++chunk)
+                function(chunk * count / chunks, (chunk + 1) * count / chunks, outputs[chunk]);
+        });
+
+        std::size_t size{};
+        for (const auto& output : outputs)
+            size += output.size();
+
+        std::string result;
+        result.reserve(size);
+
+        for (const auto& output : outputs)
+            result += output;
+
+        return result;
     }
 
 private:
-    bool IsPrime(int64_t n) {
-        if (n <= 1)
-            return false;
+    static std::size_t KeyBytes(const RSAContext& context) noexcept {
+        return RSAPadding::KeyBytes(context.Modulus().BitLength());
+    }
 
-        if (n <= 3)
-            return true;
+    /*
+        Binary containers always start with a header, text files only in
+        block mode: "S21R-BLOCK <key bytes> <length> <count>".
+    */
+    static std::string FormatHeader(const RSAHeader& header, RSAFormat format) {
+        if (format == RSAFormat::kBinary) {
+            std::string result(RSAContainer::header_size, '\0');
+            RSAContainer::WriteHeader(header, result.data());
 
-        if (n % 2 == 0 || n % 3 == 0)
-            return false;
+            return result;
+        }
 
-        for (int64_t i = 5; i * i <= n; i += 6)
-            if (n % i == 0 || n % (i + 2) == 0)
-                return false;
+        if (header.mode == RSAMode::kByte)
+            return {};
 
-        return true;
+        return std::string(block_magic_) + " " + std::to_string(header.key_bytes) + " " +
+               std::to_string(header.length) + " " + std::to_string(header.count) + "\n";
     }
 
-    int64_t EncryptBaseCode(int64_t base, int64_t exponent, int64_t modulus) {
-        int64_t result = 1;
+    static void AppendValue(std::string& out, const BigInt& value, std::size_t key_bytes, RSAFormat format) {
+        if (format == RSAFormat::kText) {
+            value.AppendString(out);
+            out += ' ';
+            return;
+        }
 
-        while (exponent > 0) {
-            if (exponent % 2 == 1)
-                result = (result * base) % modulus;
+        std::size_t offset{out.size()};
+        out.resize(offset + key_bytes);
+        value.ToLittleEndian(out.data() + offset, key_bytes);
+    }
 
-            base = (base * base) % modulus;
-            exponent /= 2;
+    /*
+        Splits a file into header and values: a binary container, a text
+        block file or a text byte-mode file (no header at all).
+    */
+    static Ciphertext ReadCiphertext(std::string_view text, const RSAContext& context) {
+        Ciphertext ciphertext;
+        RSAHeader& header{ciphertext.header};
+
+        if (RSAContainer::IsContainer(text)) {
+            RSAHeader container_header{RSAContainer::ReadHeader(text)};
+            header = container_header;
+
+            for (std::size_t i{}; i < header.count; ++i)
+                ciphertext.values.push_back(text.substr(RSAContainer::header_size + i * header.key_bytes, header.key_bytes));
+        } else {
+            ciphertext.format = RSAFormat::kText;
+            ciphertext.values = SplitTokens(text);
+
+            if (!ciphertext.values.empty() && ciphertext.values.front() == block_magic_) {
+                if (ciphertext.values.size() < 4)
+                    throw std::invalid_argument("Corrupted RSA block file: truncated header");
+
+                header.mode = RSAMode::kBlock;
+                header.key_bytes = static_cast<uint32_t>(ParseSize(ciphertext.values[1]));
+                header.length = ParseSize(ciphertext.values[2]);
+                header.count = ParseSize(ciphertext.values[3]);
+
+                ciphertext.values.erase(ciphertext.values.begin(), ciphertext.values.begin() + 4);
+            } else {
+                header.mode = RSAMode::kByte;
+                header.key_bytes = static_cast<uint32_t>(KeyBytes(context));
+                header.length = ciphertext.values.size();
+                header.count = ciphertext.values.size();
+            }
         }
 
-        return result;
+        if (header.key_bytes != KeyBytes(context))
+            throw std::invalid_argument("RSA file was encrypted with a key of another size");
+
+        if (ciphertext.values.size() != header.count || (header.mode == RSAMode::kByte && header.count != header.length))
+            throw std::invalid_argument("Corrupted RSA file: value count does not match header");
+
+        return ciphertext;
+    }
+
+    static std::vector<std::string_view> SplitTokens(std::string_view text) {
+        std::vector<std::string_view> tokens;
+
+        for (std::size_t i{}; i < text.size();) {
+            if (std::isspace(static_cast<unsigned char>(text[i]))) {
+                ++i;
+                continue;
+            }
+
+            std::size_t end{i};
+            while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])))
+                ++end;
+
+            tokens.push_back(text.substr(i, end - i));
+            i = end;
+        }
+
+        return tokens;
+    }
+
+    static BigInt ParseValue(std::string_view token, RSAFormat format, const RSAContext& context) {
+        BigInt value{format == RSAFormat::kBinary ? BigInt::FromLittleEndian(token.data(), token.size()) : BigInt::FromString(token)};
+
+        if (value >= context.Modulus())
+            throw std::invalid_argument("RSA value is out of range for this key");
+
+        return value;
+    }
+
+    static std::size_t ParseSize(std::string_view token) {
+        std::size_t value{};
+        auto [end, error]{std::from_chars(token.data(), token.data() + token.size(), value)};
+
+        if (error != std::errc{} || end != token.data() + token.size())
+            throw std::invalid_argument("Corrupted RSA block file: invalid header");
+
+        return value;
+    }
+
+    RSAKey LoadKey(std::string_view key_path) {
+        auto key_file{fsm_.read_file(fs::path(key_path))};
+
+        if (key_file.empty())
+            throw std::invalid_argument("Cannot read RSA key: " + std::string(key_path));
+
+        return RSAKey::Parse(key_file.get_text());
+    }
+
+    /*
+        p - 1 must be coprime with e for d to exist.
+    */
+    BigInt GeneratePrime(std::size_t bits) const {
+        return Primes::GenerateParallel(bits, threads_, [](const BigInt& prime) {
+            return prime.ModSmall(public_exponent_) != 1;
+        });
+    }
+
+    fs::path GetNewFilePath(std::string_view path, std::string_view postfix) {
+        std::string filename(path);
+        auto pos{filename.find_last_of(".")};
+        if (pos != std::string_view::npos)
+            filename.insert(pos, postfix);
+        else
+            filename += postfix;
+
+        return fs::path(filename);
     }
 
 private:
+    static constexpr const uint64_t public_exponent_{65537};
+    static constexpr const std::size_t byte_values_{256};
+    static constexpr const std::size_t batch_size_{64};
+    static constexpr const std::size_t min_key_bits_{128};
+    static constexpr const std::size_t max_key_bits_{8192};
+    static constexpr const std::string_view block_magic_{"S21R-BLOCK"};
+
+    std::size_t threads_{Parallel::DefaultThreads()};
+    DES des_;
     tools::filesystem::monitoring fsm_;
 };
 }  // namespace s21
@@ -0,0 +1,104 @@
+#ifndef CRYPTO_MODEL_RSA_RSA_CONTAINER_HPP
+#define CRYPTO_MODEL_RSA_RSA_CONTAINER_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace s21 {
+enum class RSAFormat : uint8_t { kBinary, kText };
+
+enum class RSAMode : uint8_t { kByte = 1, kBlock = 2 };
+
+struct RSAHeader {
+    uint8_t version{1};
+    RSAMode mode{RSAMode::kByte};
+    uint32_t key_bytes{};
+    uint64_t length{};
+    uint64_t count{};
+};
+
+/*
+    Binary RSA ciphertext container:
+
+        offset  size  field
+        0       4     magic "S21R"
+        4       1     version
+        5       1     mode (1 = one value per byte, 2 = padded blocks)
+        6       2     reserved (0)
+        8       4     key size k in bytes, little-endian
+        12      4     reserved (0)
+        16      8     original length, little-endian
+        24      8     number of values, little-endian
+        32      ...   values, k bytes each, little-endian
+*/
+class RSAContainer {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type header_size{32};
+    static constexpr const uint8_t version{1};
+
+public:
+    static bool IsContainer(std::string_view data) noexcept {
+        return data.size() >= header_size && data.substr(0, magic_.size()) == magic_ &&
+               static_cast<uint8_t>(data[4]) == version;
+    }
+
+    static void WriteHeader(const RSAHeader& header, char* out) noexcept {
+        std::memset(out, 0, header_size);
+        std::memcpy(out, magic_.data(), magic_.size());
+        out[4] = static_cast<char>(header.version);
+        out[5] = static_cast<char>(header.mode);
+
+        WriteWord(header.key_bytes, 4, out + 8);
+        WriteWord(header.length, 8, out + 16);
+        WriteWord(header.count, 8, out + 24);
+    }
+
+    static RSAHeader ReadHeader(std::string_view data) {
+        if (!IsContainer(data))
+            throw std::invalid_argument("Not an RSA container");
+
+        RSAHeader header;
+        header.version = static_cast<uint8_t>(data[4]);
+        header.mode = static_cast<RSAMode>(data[5]);
+        header.key_bytes = static_cast<uint32_t>(ReadWord(data.data() + 8, 4));
+        header.length = ReadWord(data.data() + 16, 8);
+        header.count = ReadWord(data.data() + 24, 8);
+
+        if (header.mode != RSAMode::kByte && header.mode != RSAMode::kBlock)
+            throw std::invalid_argument("Unknown RSA mode");
+
+        if (!header.key_bytes || (data.size() - header_size) / header.key_bytes != header.count ||
+            (data.size() - header_size) % header.key_bytes)
+            throw std::invalid_argument("Corrupted RSA container: body size does not match header");
+
+        return header;
+    }
+
+private:
+    static void WriteWord(uint64_t value, size_type size, char* out) noexcept {
+        for (size_type i{}; i < size; ++i)
+            out[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+
+    static uint64_t ReadWord(const char* data, size_type size) noexcept {
+        uint64_t value{};
+
+        for (size_type i{}; i < size; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (i * 8);
+
+        return value;
+    }
+
+private:
+    static constexpr const std::string_view magic_{"S21R"};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_RSA_CONTAINER_HPP
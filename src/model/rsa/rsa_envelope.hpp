@@ -0,0 +1,129 @@
+#ifndef CRYPTO_MODEL_RSA_RSA_ENVELOPE_HPP
+#define CRYPTO_MODEL_RSA_RSA_ENVELOPE_HPP
+
+#include <array>
+#include <string>
+#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+#include "bigint.hpp"
+#include "rsa_key.hpp"
+#include "rsa_padding.hpp"
+
+#include "des.hpp"
+
+namespace s21 {
+/*
+    Hybrid RSA envelope: the data is encrypted with a random 3DES session
+    key in CTR mode, and only the session key with RSA, so a file costs a
+    single exponentiation whatever its size.
+
+        offset  size  field
+        0       4     magic "S21E"
+        4       1     version
+        5       3     reserved (0)
+        8       4     key size k in bytes, little-endian
+        12      4     reserved (0)
+        16      k     PKCS #1 v1.5 block holding k1 k2 k3, RSA-encrypted,
+                      little-endian
+        16 + k  ...   DESContainer with the data
+*/
+class RSAEnvelope {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type header_size{16};
+    static constexpr const uint8_t version{1};
+    static constexpr const size_type session_key_size{24};
+
+public:
+    static bool IsEnvelope(std::string_view data) noexcept {
+        return data.size() >= header_size && data.substr(0, magic_.size()) == magic_ &&
+               static_cast<uint8_t>(data[4]) == version;
+    }
+
+    /*
+        context holds the public key, des does the bulk encryption.
+    */
+    static std::string Seal(std::string_view text, const RSAContext& context, DES& des) {
+        size_type key_bytes{RSAPadding::KeyBytes(context.Modulus().BitLength())};
+
+        if (key_bytes < session_key_size + RSAPadding::overhead)
+            throw std::invalid_argument("RSA key is too small to wrap a session key");
+
+        std::random_device device;
+        std::array<uint64_t, 3> keys;
+        unsigned char session_data[session_key_size];
+
+        for (size_type i{}; i < keys.size(); ++i) {
+            keys[i] = (static_cast<uint64_t>(device()) << 32) | device();
+
+            for (size_type j{}; j < sizeof(uint64_t); ++j)
+                session_data[i * sizeof(uint64_t) + j] = static_cast<unsigned char>(keys[i] >> (56 - j * 8));
+        }
+
+        std::vector<unsigned char> block(key_bytes);
+        RSAPadding::Pad(reinterpret_cast<const char*>(session_data), session_key_size, block.data(), key_bytes, device);
+
+        std::string envelope(header_size + key_bytes, '\0');
+        std::memcpy(envelope.data(), magic_.data(), magic_.size());
+        envelope[4] = static_cast<char>(version);
+
+        for (size_type i{}; i < 4; ++i)
+            envelope[8 + i] = static_cast<char>((key_bytes >> (i * 8)) & 0xFF);
+
+        context.Apply(BigInt::FromBytes(block.data(), key_bytes)).ToLittleEndian(envelope.data() + header_size, key_bytes);
+        envelope += des.Encrypt(text, DES3Key{keys[0], keys[1], keys[2]}, DESMode::kCTR);
+
+        return envelope;
+    }
+
+    /*
+        context holds the private key.
+    */
+    static std::string Open(std::string_view data, const RSAContext& context, DES& des) {
+        if (!IsEnvelope(data))
+            throw std::invalid_argument("Not an RSA envelope");
+
+        size_type key_bytes{};
+        for (size_type i{}; i < 4; ++i)
+            key_bytes |= static_cast<size_type>(static_cast<unsigned char>(data[8 + i])) << (i * 8);
+
+        if (key_bytes != RSAPadding::KeyBytes(context.Modulus().BitLength()))
+            throw std::invalid_argument("RSA envelope was sealed with a key of another size");
+
+        if (data.size() < header_size + key_bytes)
+            throw std::invalid_argument("Corrupted RSA envelope: truncated session key");
+
+        BigInt wrapped{BigInt::FromLittleEndian(data.data() + header_size, key_bytes)};
+        if (wrapped >= context.Modulus())
+            throw std::invalid_argument("RSA value is out of range for this key");
+
+        std::vector<unsigned char> block(key_bytes);
+        context.Apply(wrapped).ToBytes(block.data(), key_bytes);
+
+        std::string session_data;
+        RSAPadding::Unpad(block.data(), key_bytes, session_data);
+
+        if (session_data.size() != session_key_size)
+            throw std::invalid_argument("Invalid RSA envelope session key (wrong key?)");
+
+        std::array<uint64_t, 3> keys{};
+        for (size_type i{}; i < session_key_size; ++i)
+            keys[i / sizeof(uint64_t)] = (keys[i / sizeof(uint64_t)] << 8) | static_cast<unsigned char>(session_data[i]);
+
+        return des.Decrypt(data.substr(header_size + key_bytes), DES3Key{keys[0], keys[1], keys[2]});
+    }
+
+private:
+    static constexpr const std::string_view magic_{"S21E"};
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_RSA_ENVELOPE_HPP
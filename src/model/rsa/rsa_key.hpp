@@ -0,0 +1,174 @@
+#ifndef CRYPTO_MODEL_RSA_RSA_KEY_HPP
+#define CRYPTO_MODEL_RSA_RSA_KEY_HPP
+
+#include <string>
+#include <cctype>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "bigint.hpp"
+#include "montgomery.hpp"
+#include "montgomery_batch.hpp"
+
+namespace s21 {
+/*
+    Key files hold whitespace-separated decimal numbers: "e n" for the
+    public key, "d n" for the private one. Private keys may carry the CRT
+    fields as well, "d n p q dP dQ qInv" with dP = d mod (p - 1),
+    dQ = d mod (q - 1) and qInv = q^-1 mod p.
+*/
+struct RSAKey {
+    struct CRT {
+        BigInt p;
+        BigInt q;
+        BigInt dp;
+        BigInt dq;
+        BigInt q_inv;
+    };
+
+    BigInt exponent;
+    BigInt modulus;
+    std::optional<CRT> crt;
+
+    static RSAKey Parse(std::string_view text) {
+        std::vector<BigInt> fields{ParseFields(text)};
+
+        if (fields.size() != 2 && fields.size() != 7)
+            throw std::invalid_argument("RSA key must hold an exponent and a modulus (and optionally p q dP dQ qInv)");
+
+        if (fields[1] < BigInt{2} || !fields[1].IsOdd())
+            throw std::invalid_argument("Invalid RSA modulus");
+
+        RSAKey key{std::move(fields[0]), std::move(fields[1]), std::nullopt};
+
+        if (fields.size() == 7) {
+            key.crt = CRT{std::move(fields[2]), std::move(fields[3]), std::move(fields[4]), std::move(fields[5]), std::move(fields[6])};
+
+            if (key.crt->p * key.crt->q != key.modulus || !key.crt->p.IsOdd() || !key.crt->q.IsOdd())
+                throw std::invalid_argument("RSA key CRT primes do not match the modulus");
+        }
+
+        return key;
+    }
+
+    /*
+        Private key with the CRT fields derived from the primes.
+    */
+    static RSAKey MakePrivate(const BigInt& d, const BigInt& p, const BigInt& q) {
+        CRT crt{p, q, d % (p - BigInt{1}), d % (q - BigInt{1}), BigInt::ModInverse(q, p)};
+
+        return RSAKey{d, p * q, std::move(crt)};
+    }
+
+    std::string ToString() const {
+        std::string result{exponent.ToString() + " " + modulus.ToString()};
+
+        if (crt)
+            for (const BigInt* field : {&crt->p, &crt->q, &crt->dp, &crt->dq, &crt->q_inv})
+                result += " " + field->ToString();
+
+        return result;
+    }
+
+    static std::vector<BigInt> ParseFields(std::string_view text) {
+        std::vector<BigInt> fields;
+
+        for (std::size_t i{}; i < text.size();) {
+            if (std::isspace(static_cast<unsigned char>(text[i]))) {
+                ++i;
+                continue;
+            }
+
+            std::size_t end{i};
+            while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])))
+                ++end;
+
+            fields.push_back(BigInt::FromString(text.substr(i, end - i)));
+            i = end;
+        }
+
+        return fields;
+    }
+};
+
+/*
+    A loaded key with its Montgomery contexts set up once. Private keys
+    with CRT fields exponentiate modulo p and q (half-size numbers,
+    half-size exponents) and recombine with Garner's formula
+        m = m2 + q * (qInv * (m1 - m2) mod p),
+    which is 3-4 times faster than one exponentiation modulo n.
+*/
+class RSAContext {
+public:
+    using size_type = std::size_t;
+
+public:
+    explicit RSAContext(RSAKey key) :
+        key_(std::move(key)),
+        modulus_(key_.modulus)
+    {
+        if (key_.crt) {
+            mod_p_.emplace(key_.crt->p);
+            mod_q_.emplace(key_.crt->q);
+        }
+    }
+
+    ~RSAContext() = default;
+
+public:
+    /*
+        value^exponent mod n; value must be < n.
+    */
+    BigInt Apply(const BigInt& value) const {
+        if (!key_.crt)
+            return modulus_.Pow(value, key_.exponent);
+
+        return Combine(mod_p_->Pow(value, key_.crt->dp), mod_q_->Pow(value, key_.crt->dq));
+    }
+
+    /*
+        Apply() on values[0, count) in place, as lockstep batches (see
+        MontgomeryBatch).
+    */
+    void Apply(BigInt* values, size_type count) const {
+        if (!key_.crt) {
+            modulus_.Pow(values, count, key_.exponent);
+            return;
+        }
+
+        std::vector<BigInt> m1(values, values + count);
+        mod_p_->Pow(m1.data(), count, key_.crt->dp);
+        mod_q_->Pow(values, count, key_.crt->dq);
+
+        for (size_type i{}; i < count; ++i)
+            values[i] = Combine(m1[i], values[i]);
+    }
+
+    const RSAKey& Key() const noexcept { return key_; }
+
+    const BigInt& Modulus() const noexcept { return key_.modulus; }
+
+    bool HasCRT() const noexcept { return key_.crt.has_value(); }
+
+private:
+    BigInt Combine(const BigInt& m1, const BigInt& m2) const {
+        const RSAKey::CRT& crt{*key_.crt};
+
+        BigInt m2_mod_p{m2 % crt.p};
+        BigInt difference{m1 >= m2_mod_p ? m1 - m2_mod_p : m1 + (crt.p - m2_mod_p)};
+        BigInt h{crt.q_inv * difference % crt.p};
+
+        return m2 + h * crt.q;
+    }
+
+private:
+    RSAKey key_;
+    MontgomeryBatch modulus_;
+    std::optional<MontgomeryBatch> mod_p_;
+    std::optional<MontgomeryBatch> mod_q_;
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_RSA_KEY_HPP
@@ -0,0 +1,71 @@
+#ifndef CRYPTO_MODEL_RSA_RSA_PADDING_HPP
+#define CRYPTO_MODEL_RSA_RSA_PADDING_HPP
+
+#include <string>
+#include <random>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace s21 {
+/*
+    EME-PKCS1-v1_5 (RFC 8017, 7.2.1): a k-byte block, k the modulus size
+    in bytes, is
+
+        0x00 0x02 PS 0x00 M
+
+    with PS at least 8 random non-zero bytes, so one block carries up to
+    k - 11 message bytes. The leading zero byte keeps the block below n.
+*/
+class RSAPadding {
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr const size_type overhead{11};
+    static constexpr const size_type min_random_size{8};
+
+public:
+    static size_type KeyBytes(size_type modulus_bits) noexcept {
+        return (modulus_bits + 7) / 8;
+    }
+
+    static size_type MaxMessageSize(size_type key_bytes) {
+        if (key_bytes <= overhead)
+            throw std::invalid_argument("RSA key is too small for block mode");
+
+        return key_bytes - overhead;
+    }
+
+    template <typename Engine>
+    static void Pad(const char* message, size_type size, unsigned char* block, size_type key_bytes, Engine& engine) {
+        if (size > MaxMessageSize(key_bytes))
+            throw std::invalid_argument("Message does not fit into one RSA block");
+
+        std::uniform_int_distribution<unsigned> distribution(1, 255);
+        size_type random_end{key_bytes - size - 1};
+
+        block[0] = 0x00;
+        block[1] = 0x02;
+
+        for (size_type i{2}; i < random_end; ++i)
+            block[i] = static_cast<unsigned char>(distribution(engine));
+
+        block[random_end] = 0x00;
+        std::memcpy(block + random_end + 1, message, size);
+    }
+
+    static void Unpad(const unsigned char* block, size_type key_bytes, std::string& out) {
+        size_type separator{2};
+        while (separator < key_bytes && block[separator])
+            ++separator;
+
+        if (block[0] != 0x00 || block[1] != 0x02 || separator == key_bytes || separator < 2 + min_random_size)
+            throw std::invalid_argument("Invalid RSA padding (wrong key or corrupted file)");
+
+        out.append(reinterpret_cast<const char*>(block) + separator + 1, key_bytes - separator - 1);
+    }
+};
+} // namespace s21
+
+#endif // CRYPTO_MODEL_RSA_RSA_PADDING_HPP
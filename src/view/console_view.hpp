@@ -102,30 +102,10 @@ private:
                     huffman_controller_.Encrypt(file_path);
                     
             } else if (opt == 2) {
-                std::string file_path{"null"};
-                std::string config_path{"null"};
-                while (true) {
-                    tools::console::console_clear();
-                    tools::console::print_text("HUFFMAN:\n", color::green, mod::bold);
-                    tools::console::print_text("1.", color::green, mod::bold, " ");
-                    tools::console::print_text("Select encoded file\t(" + file_path + ")", color::blue);
-                    tools::console::print_text("2.", color::green, mod::bold, " ");
-                    tools::console::print_text("Select config file\t(" + config_path + ")\n", color::blue);
-                    tools::console::print_text("3. CONFIRM", color::red, mod::bold);
-                    tools::console::print_text("0. EXIT", color::red, mod::bold, "\n\n");
-                    tools::console::print_text("Select menu item:", color::green, mod::bold, " ");
-
-                    opt = tools::console::get_correct_int();
-                    if (opt == 1)
-                        file_path = fsm_.get_file_path();
-                    else if (opt == 2)
-                        config_path = fsm_.get_file_path();
-                    else if (opt == 0 || opt == 3)
-                        break;
-                }
+                std::string file_path{fsm_.get_file_path()};
 
-                if (opt != 0 && file_path != "null" && config_path != "null")
-                    huffman_controller_.Decrypt(file_path, config_path);
+                if (!file_path.empty())
+                    huffman_controller_.Decrypt(file_path);
             } else if (opt == 0) {
                 break;
             }
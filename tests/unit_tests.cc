@@ -49,10 +49,187 @@ TEST(Enigma, enigma_test_binary_file_load_config) {
     EXPECT_EQ(file_a.get_text(), file_b.get_text());
 }
 
+TEST(Enigma, enigma_test_rotor_stepping) {
+    s21::Rotor rotor;
+    std::vector<char> rotated(128);
+    for (int i{}; i < 128; ++i)
+        rotated[i] = rotor[i];
+
+    s21::Rotor copy(rotated);
+    for (int step{}; step < 300; ++step) {
+        for (int i{}; i < 128; ++i) {
+            EXPECT_EQ(copy[i], rotated[i]);
+            EXPECT_EQ(rotated[copy.Find(static_cast<char>(i))], i);
+        }
+
+        std::rotate(rotated.rbegin(), rotated.rbegin() + 1, rotated.rend());
+        copy.Shift();
+    }
+
+    rotated[5] = rotated[6];
+    EXPECT_THROW(s21::Rotor{rotated}, std::invalid_argument);
+}
+
+TEST(Enigma, enigma_test_keystream_random_access) {
+    s21::Reflector reflector;
+    std::vector<s21::Rotor> rotors(5);
+    rotors[2].Shift(17);
+
+    std::mt19937 engine(9);
+    std::string text(5000, '\0');
+    for (auto& c : text)
+        c = static_cast<char>(engine());
+
+    std::string expected{text};
+    std::vector<s21::Rotor> machine{rotors};
+    for (auto& c : expected) {
+        int code{static_cast<unsigned char>(c)};
+        if (code > 127)
+            continue;
+
+        for (auto& rotor : machine)
+            code = rotor[code];
+        code = reflector[code];
+        for (std::size_t i{machine.size()}; i-- > 0;) {
+            code = machine[i].Find(static_cast<char>(code));
+            machine[i].Shift();
+        }
+
+        c = static_cast<char>(code);
+    }
+
+    s21::EnigmaKeystream keystream(reflector, rotors);
+    std::string whole{text};
+    EXPECT_EQ(keystream.EncryptAt(0, whole.data(), whole.size()), s21::EnigmaKeystream::Steps(text.data(), text.size()));
+    EXPECT_EQ(whole, expected);
+
+    std::string pieces{text};
+    std::size_t offset{};
+    for (std::size_t begin{}, size{1}; begin < pieces.size(); begin += size, size = size * 3 + 1) {
+        size = std::min(size, pieces.size() - begin);
+        offset += keystream.EncryptAt(offset, pieces.data() + begin, size);
+    }
+    EXPECT_EQ(pieces, expected);
+
+    keystream.EncryptAt(0, pieces.data(), pieces.size());
+    EXPECT_EQ(pieces, text);
+}
+
+static void CheckKeystreamBackend(s21::EnigmaBackend backend) {
+    s21::EnigmaKeystream keystream(s21::Reflector{}, std::vector<s21::Rotor>(3));
+    std::mt19937 engine(11);
+
+    for (unsigned high_every : {0u, 2u, 97u}) {
+        std::string text(3 * 4096 + 3, '\0');
+        for (std::size_t i{}; i < text.size(); ++i)
+            text[i] = static_cast<char>(high_every && engine() % high_every == 0 ? 128 + engine() % 128 : engine() % 128);
+
+        // a 7-bit stretch inside mixed input, so both kinds of vector block run
+        if (high_every)
+            for (std::size_t i{4096}; i < 2 * 4096; ++i)
+                text[i] = static_cast<char>(static_cast<unsigned char>(text[i]) & 0x7F);
+
+        std::string expected{text};
+        std::size_t steps{keystream.EncryptAt(77, expected.data(), expected.size(), s21::EnigmaBackend::kScalar)};
+
+        std::string encrypted{text};
+        std::size_t head{keystream.EncryptAt(77, encrypted.data(), 5, backend)};
+        EXPECT_EQ(head + keystream.EncryptAt(77 + head, encrypted.data() + 5, encrypted.size() - 5, backend), steps);
+        EXPECT_EQ(encrypted, expected);
+    }
+}
+
+TEST(Enigma, enigma_test_keystream_backends) {
+    CheckKeystreamBackend(s21::EnigmaBackend::kAuto);
+}
+
+TEST(Enigma, enigma_test_keystream_avx2) {
+    if (s21::EnigmaKeystream::Resolve(s21::EnigmaBackend::kAVX2) != s21::EnigmaBackend::kAVX2)
+        GTEST_SKIP() << "AVX2 is not available on this CPU";
+
+    CheckKeystreamBackend(s21::EnigmaBackend::kAVX2);
+}
+
+TEST(Enigma, enigma_test_keystream_avx512) {
+    if (s21::EnigmaKeystream::Resolve(s21::EnigmaBackend::kAVX512) != s21::EnigmaBackend::kAVX512)
+        GTEST_SKIP() << "AVX-512 F/BW/VBMI2 is not available on this CPU";
+
+    CheckKeystreamBackend(s21::EnigmaBackend::kAVX512);
+}
+
+TEST(Enigma, enigma_test_keystream_rotor_counts) {
+    s21::Reflector reflector;
+
+    for (std::size_t count{1}; count <= s21::EnigmaKeystream::max_unrolled_rotors + 1; ++count) {
+        std::vector<s21::Rotor> rotors(count);
+        rotors[count / 2].Shift(count * 5);
+        s21::EnigmaKeystream keystream(reflector, rotors);
+
+        for (std::size_t step{}; step < s21::EnigmaKeystream::period; step += 31) {
+            for (int c{}; c < 128; ++c) {
+                int code{c};
+                for (const auto& rotor : rotors) {
+                    s21::Rotor stepped{rotor};
+                    stepped.Shift(step);
+                    code = stepped[code];
+                }
+                code = reflector[code];
+                for (std::size_t i{count}; i-- > 0;) {
+                    s21::Rotor stepped{rotors[i]};
+                    stepped.Shift(step);
+                    code = stepped.Find(static_cast<char>(code));
+                }
+
+                EXPECT_EQ(keystream.Table(step)[c], code);
+            }
+        }
+    }
+}
+
+TEST(Enigma, enigma_test_resumable) {
+    const std::string path{"../../datasets/files/enigma_resume.bin"};
+    const std::string encoded_path{"../../datasets/files/enigma_resume_encoded.bin"};
+    tools::filesystem::monitoring fsm_;
+
+    std::mt19937 engine(21);
+    std::string text(300000, '\0');
+    for (auto& c : text)
+        c = static_cast<char>(engine());
+    fsm_.create_file(tools::filesystem::file_t(fs::path(path), text.data(), text.size()));
+
+    s21::Enigma e("../../datasets/configurations/enigma_config.cfg");
+    e.SetStreamWindow(64 << 10);
+    e.Encrypt(path);
+    std::string expected{fsm_.read_file(fs::path(encoded_path)).get_text()};
+
+    e.EncryptResumable(path);
+    EXPECT_EQ(fsm_.read_file(fs::path(encoded_path)).get_text(), expected);
+    auto checkpoint_path{s21::EnigmaCheckpoint::PathFor(fs::path(encoded_path))};
+    EXPECT_FALSE(fs::exists(checkpoint_path));
+
+    std::size_t offset{3 * e.GetStreamWindow()};
+    std::string interrupted(offset, 'Z');
+    interrupted += std::string(1000, '?');
+    fsm_.create_file(tools::filesystem::file_t(fs::path(encoded_path), interrupted.data(), interrupted.size()));
+    s21::EnigmaCheckpoint{e.ConfigHash(), text.size(), offset, s21::EnigmaKeystream::Steps(text.data(), offset) % 128}.Save(checkpoint_path);
+
+    e.EncryptResumable(path);
+    std::string resumed{fsm_.read_file(fs::path(encoded_path)).get_text()};
+    EXPECT_EQ(resumed, std::string(offset, 'Z') + expected.substr(offset));
+    EXPECT_FALSE(fs::exists(checkpoint_path));
+
+    s21::EnigmaCheckpoint{e.ConfigHash() + 1, text.size(), offset, 0}.Save(checkpoint_path);
+    e.EncryptResumable(path);
+    EXPECT_EQ(fsm_.read_file(fs::path(encoded_path)).get_text(), expected);
+
+    fs::remove(path);
+    fs::remove(encoded_path);
+}
+
 TEST(Huffman, huffman_test_simple_file) {
     s21::Huffman h;
     h.Encode("../../datasets/files/test.txt");
-    h.Decode("../../datasets/files/test_encoded.txt", "../../datasets/files/test_encoded.cfg");
+    h.Decode("../../datasets/files/test_encoded.txt");
     tools::filesystem::monitoring fsm_;
     auto file_a{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
     auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
@@ -62,13 +239,98 @@ TEST(Huffman, huffman_test_simple_file) {
 TEST(Huffman, huffman_test_binary_file) {
     s21::Huffman h;
     h.Encode("../../datasets/files/test_binary.bin");
-    h.Decode("../../datasets/files/test_binary_encoded.bin", "../../datasets/files/test_binary_encoded.cfg");
+    h.Decode("../../datasets/files/test_binary_encoded.bin");
     tools::filesystem::monitoring fsm_;
     auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
     auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
     EXPECT_EQ(file_a.get_text(), file_b.get_text());
 }
 
+TEST(Huffman, huffman_test_container) {
+    tools::filesystem::monitoring fsm_;
+    s21::Huffman h;
+
+    auto text{fsm_.read_file(fs::path("../../datasets/files/test.txt")).get_text()};
+    h.Encode("../../datasets/files/test.txt");
+    auto encoded{fsm_.read_file(fs::path("../../datasets/files/test_encoded.txt")).get_text()};
+    auto header{s21::HuffmanContainer::ReadHeader(encoded)};
+    EXPECT_EQ(header.length, text.size());
+    EXPECT_LT(encoded.size(), text.size() + s21::HuffmanContainer::header_size);
+    EXPECT_FALSE(fs::exists("../../datasets/files/test_encoded_huffman.cfg"));
+
+    const std::string path{"../../datasets/files/huffman_edge.txt"};
+    for (const std::string& sample : {std::string(), std::string(1000, 'a'), std::string("ab")}) {
+        fsm_.create_file(tools::filesystem::file_t(fs::path(path), sample));
+        h.Encode(path);
+        h.Decode("../../datasets/files/huffman_edge_encoded.txt");
+        EXPECT_EQ(fsm_.read_file(fs::path("../../datasets/files/huffman_edge_encoded_decoded.txt")).get_text(), sample);
+    }
+    fs::remove(path);
+
+    encoded[16 + 'a'] = 1;
+    encoded[16 + 'b'] = 1;
+    encoded[16 + 'c'] = 1;
+    EXPECT_THROW(s21::HuffmanContainer::ReadHeader(encoded), std::invalid_argument);
+    EXPECT_THROW(s21::HuffmanContainer::ReadHeader(encoded.substr(0, 100)), std::invalid_argument);
+}
+
+TEST(Huffman, huffman_test_length_limit) {
+    tools::filesystem::monitoring fsm_;
+    s21::Huffman h;
+
+    std::string text;
+    for (std::size_t symbol{}, a{1}, b{1}; symbol < 24; ++symbol, b += a, a = b - a)
+        text += std::string(a, static_cast<char>('A' + symbol));
+    std::shuffle(text.begin(), text.end(), std::mt19937(23));
+
+    const std::string path{"../../datasets/files/huffman_skewed.txt"};
+    const std::string encoded_path{"../../datasets/files/huffman_skewed_encoded.txt"};
+    fsm_.create_file(tools::filesystem::file_t(fs::path(path), text));
+    h.Encode(path);
+
+    auto encoded{fsm_.read_file(fs::path(encoded_path)).get_text()};
+    auto header{s21::HuffmanContainer::ReadHeader(encoded)};
+    EXPECT_EQ(*std::max_element(header.code_lengths.begin(), header.code_lengths.end()), s21::HuffmanContainer::max_code_length);
+
+    h.Decode(encoded_path);
+    EXPECT_EQ(fsm_.read_file(fs::path("../../datasets/files/huffman_skewed_encoded_decoded.txt")).get_text(), text);
+
+    encoded.resize(encoded.size() - 8);
+    fsm_.create_file(tools::filesystem::file_t(fs::path(encoded_path), encoded));
+    EXPECT_THROW(h.Decode(encoded_path), std::invalid_argument);
+
+    for (uint64_t length : {uint64_t{1} << 31, uint64_t{1} << 40}) {
+        std::string claimed{encoded.substr(0, s21::HuffmanContainer::header_size + 1)};
+        for (std::size_t i{}; i < 8; ++i)
+            claimed[8 + i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+
+        fsm_.create_file(tools::filesystem::file_t(fs::path(encoded_path), claimed));
+        EXPECT_THROW(h.Decode(encoded_path), std::invalid_argument);
+    }
+
+    fs::remove(path);
+}
+
+TEST(Huffman, huffman_test_reuse) {
+    tools::filesystem::monitoring fsm_;
+    s21::Huffman h;
+    std::mt19937 engine(25);
+
+    const std::string path{"../../datasets/files/huffman_reuse.bin"};
+    for (std::size_t alphabet : {1u, 2u, 7u, 100u, 256u, 256u}) {
+        std::string text(alphabet * 40 + engine() % 100, '\0');
+        for (std::size_t i{}; i < text.size(); ++i)
+            text[i] = static_cast<char>(i < alphabet ? i : engine() % (engine() % alphabet + 1));
+
+        fsm_.create_file(tools::filesystem::file_t(fs::path(path), text.data(), text.size()));
+        h.Encode(path);
+        h.Decode("../../datasets/files/huffman_reuse_encoded.bin");
+        EXPECT_EQ(fsm_.read_file(fs::path("../../datasets/files/huffman_reuse_encoded_decoded.bin")).get_text(), text);
+    }
+
+    fs::remove(path);
+}
+
 TEST(RSA, rsa_test_simple_file) {
     s21::RSA r;
     r.GenerateKeys("../../datasets/configurations/");
@@ -91,6 +353,258 @@ TEST(RSA, rsa_test_binary_file) {
     EXPECT_EQ(file_a.get_text(), file_b.get_text());
 }
 
+TEST(RSA, rsa_test_bigint_arithmetic) {
+    s21::BigInt a{s21::BigInt::FromString("123456789012345678901234567890123456789012345678901234567890")};
+    s21::BigInt b{s21::BigInt::FromString("98765432109876543210987654321")};
+    EXPECT_EQ(a.ToString(), "123456789012345678901234567890123456789012345678901234567890");
+    EXPECT_EQ((a * b).ToString(), "12193263113702179522618503273374485596337448559633744855963362292333223746380111126352690");
+
+    auto [q, r]{s21::BigInt::DivMod(a, b)};
+    EXPECT_EQ(q * b + r, a);
+    EXPECT_LT(r, b);
+    EXPECT_EQ((a - a).ToString(), "0");
+    EXPECT_EQ(((s21::BigInt{1} << 200) >> 190).ToString(), "1024");
+    EXPECT_THROW(s21::BigInt::FromString("12a"), std::invalid_argument);
+
+    s21::BigInt m{s21::BigInt::FromString("1000000000000000000000000000057")};
+    EXPECT_EQ(s21::BigInt::ModInverse(a, m) * a % m, s21::BigInt{1});
+}
+
+TEST(RSA, rsa_test_montgomery_pow) {
+    s21::BigInt mersenne{(s21::BigInt{1} << 521) - s21::BigInt{1}};
+    s21::Montgomery montgomery(mersenne);
+    EXPECT_EQ(montgomery.Pow(s21::BigInt{3}, mersenne - s21::BigInt{1}), s21::BigInt{1});
+    EXPECT_EQ(montgomery.Pow(s21::BigInt{2}, s21::BigInt{521}), s21::BigInt{1});
+    EXPECT_EQ(montgomery.Pow(s21::BigInt{7}, s21::BigInt{}), s21::BigInt{1});
+
+    std::mt19937_64 engine(42);
+    EXPECT_TRUE(s21::Primes::IsProbablePrime(mersenne, engine));
+    EXPECT_FALSE(s21::Primes::IsProbablePrime(mersenne + s21::BigInt{2}, engine));
+    EXPECT_FALSE(s21::Primes::IsProbablePrime(s21::BigInt::FromString("3215031751"), engine));
+    EXPECT_EQ(s21::Primes::Generate(256, engine).BitLength(), 256);
+
+    s21::Montgomery small(s21::BigInt{3233});
+    EXPECT_EQ(small.Pow(s21::BigInt{65}, s21::BigInt{17}), s21::BigInt{2790});
+}
+
+TEST(RSA, rsa_test_montgomery_batch) {
+    std::mt19937_64 engine(3);
+
+    for (std::size_t bits : {12, 61, 521, 1024, 2048}) {
+        s21::BigInt modulus{s21::BigInt::Random(bits, engine)};
+        modulus.SetBit(0);
+        modulus.SetBit(bits - 1);
+
+        s21::Montgomery scalar(modulus);
+        s21::MontgomeryBatch batch(modulus);
+
+        for (s21::BigInt exponent : {s21::BigInt{1}, s21::BigInt{65537}, s21::BigInt::Random(bits, engine)}) {
+            std::vector<s21::BigInt> values{s21::BigInt{}, s21::BigInt{1}, modulus - s21::BigInt{1}, modulus + s21::BigInt{5}};
+            for (std::size_t i{}; i < 9; ++i)
+                values.push_back(s21::BigInt::Random(bits, engine) % modulus);
+
+            for (auto backend : {s21::MontgomeryBackend::kScalar, s21::MontgomeryBackend::kAVX2, s21::MontgomeryBackend::kIFMA}) {
+                std::vector<s21::BigInt> results(values);
+                batch.Pow(results.data(), results.size(), exponent, backend);
+
+                for (std::size_t i{}; i < values.size(); ++i)
+                    EXPECT_EQ(results[i], scalar.Pow(values[i], exponent));
+            }
+        }
+    }
+}
+
+TEST(RSA, rsa_test_prime_generation) {
+    const auto& primes{s21::Primes::SmallPrimes()};
+    EXPECT_EQ(primes.front(), 3u);
+    EXPECT_EQ(primes.size(), 1027u);
+
+    std::mt19937_64 engine(7);
+    for (std::size_t threads : {1, 4}) {
+        s21::BigInt prime{s21::Primes::GenerateParallel(512, threads, [](const s21::BigInt& p) { return p.ModSmall(65537) != 1; })};
+        EXPECT_EQ(prime.BitLength(), 512);
+        EXPECT_NE(prime.ModSmall(65537), 1u);
+        EXPECT_TRUE(s21::Primes::IsProbablePrime(prime, engine));
+    }
+}
+
+TEST(RSA, rsa_test_key_sizes) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+
+    for (std::size_t bits : {512, 3072}) {
+        r.GenerateKeys("../../datasets/configurations/", bits);
+        auto key{s21::RSAKey::Parse(fsm_.read_file(fs::path("../../datasets/configurations/public_key")).get_text())};
+        EXPECT_EQ(key.modulus.BitLength(), bits);
+
+        r.Encode("../../datasets/files/test.txt", "../../datasets/configurations/public_key");
+        r.Decode("../../datasets/files/test_encoded.txt", "../../datasets/configurations/private_key");
+        auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+        EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    }
+
+    EXPECT_THROW(r.GenerateKeys("../../datasets/configurations/", 64), std::invalid_argument);
+}
+
+TEST(RSA, rsa_test_crt_private_key) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    r.GenerateKeys("../../datasets/configurations/", 1024);
+
+    auto private_text{fsm_.read_file(fs::path("../../datasets/configurations/private_key")).get_text()};
+    s21::RSAKey key{s21::RSAKey::Parse(private_text)};
+    ASSERT_TRUE(key.crt.has_value());
+    EXPECT_EQ(s21::RSAKey::Parse(key.ToString()).ToString(), private_text);
+
+    s21::RSAKey plain_key{key.exponent, key.modulus, std::nullopt};
+    s21::RSAContext crt(key), plain(plain_key);
+    std::mt19937_64 engine(3);
+
+    for (int i{}; i < 4; ++i) {
+        s21::BigInt value{s21::BigInt::Random(1000, engine)};
+        EXPECT_EQ(crt.Apply(value), plain.Apply(value));
+    }
+
+    fsm_.create_file(tools::filesystem::file_t(fs::path("../../datasets/configurations/private_key"), plain_key.ToString()));
+    r.Encode("../../datasets/files/test.txt", "../../datasets/configurations/public_key");
+    r.Decode("../../datasets/files/test_encoded.txt", "../../datasets/configurations/private_key");
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+
+    key.crt->p = key.crt->p + s21::BigInt{2};
+    EXPECT_THROW(s21::RSAKey::Parse(key.ToString()), std::invalid_argument);
+}
+
+TEST(RSA, rsa_test_block_mode) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    r.GenerateKeys("../../datasets/configurations/", 1024);
+
+    for (const char* name : {"test.txt", "test_binary.bin"}) {
+        std::string path{std::string("../../datasets/files/") + name};
+        std::string stem{path.substr(0, path.find_last_of("."))}, extension{path.substr(path.find_last_of("."))};
+
+        r.Encode(path, "../../datasets/configurations/public_key", s21::RSAMode::kBlock);
+        r.Decode(stem + "_encoded" + extension, "../../datasets/configurations/private_key");
+        auto file_a{fsm_.read_file(fs::path(path))};
+        auto file_b{fsm_.read_file(fs::path(stem + "_encoded_decoded" + extension))};
+        EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    }
+
+    auto block_size{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded.bin")).size()};
+    r.Encode("../../datasets/files/test_binary.bin", "../../datasets/configurations/public_key");
+    auto byte_size{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded.bin")).size()};
+    EXPECT_LT(block_size * 50, byte_size);
+
+    unsigned char block[128];
+    std::mt19937_64 engine(1);
+    std::string message(117, 'x'), unpadded;
+    s21::RSAPadding::Pad(message.data(), message.size(), block, sizeof(block), engine);
+    s21::RSAPadding::Unpad(block, sizeof(block), unpadded);
+    EXPECT_EQ(unpadded, message);
+    EXPECT_THROW(s21::RSAPadding::Pad(message.data(), 118, block, sizeof(block), engine), std::invalid_argument);
+    block[1] = 0x01;
+    EXPECT_THROW(s21::RSAPadding::Unpad(block, sizeof(block), unpadded), std::invalid_argument);
+}
+
+TEST(RSA, rsa_test_container_formats) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    r.GenerateKeys("../../datasets/configurations/", 512);
+    auto source{fsm_.read_file(fs::path("../../datasets/files/test.txt")).get_text()};
+
+    for (auto mode : {s21::RSAMode::kByte, s21::RSAMode::kBlock}) {
+        for (auto format : {s21::RSAFormat::kBinary, s21::RSAFormat::kText}) {
+            r.Encode("../../datasets/files/test.txt", "../../datasets/configurations/public_key", mode, format);
+            auto encoded{fsm_.read_file(fs::path("../../datasets/files/test_encoded.txt")).get_text()};
+            EXPECT_EQ(s21::RSAContainer::IsContainer(encoded), format == s21::RSAFormat::kBinary);
+
+            if (format == s21::RSAFormat::kBinary) {
+                s21::RSAHeader header{s21::RSAContainer::ReadHeader(encoded)};
+                EXPECT_EQ(header.mode, mode);
+                EXPECT_EQ(header.key_bytes, 64u);
+                EXPECT_EQ(header.length, source.size());
+                EXPECT_EQ(encoded.size(), s21::RSAContainer::header_size + header.count * 64);
+            }
+
+            r.Decode("../../datasets/files/test_encoded.txt", "../../datasets/configurations/private_key");
+            EXPECT_EQ(fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt")).get_text(), source);
+        }
+    }
+
+    r.Encode("../../datasets/files/test.txt", "../../datasets/configurations/public_key", s21::RSAMode::kBlock);
+    auto encoded{fsm_.read_file(fs::path("../../datasets/files/test_encoded.txt")).get_text()};
+    fsm_.create_file(tools::filesystem::file_t(fs::path("../../datasets/files/test_encoded.txt"), encoded.substr(0, encoded.size() - 1)));
+    EXPECT_THROW(r.Decode("../../datasets/files/test_encoded.txt", "../../datasets/configurations/private_key"), std::invalid_argument);
+
+    fsm_.create_file(tools::filesystem::file_t(fs::path("../../datasets/files/test_encoded.txt"), encoded));
+    r.GenerateKeys("../../datasets/configurations/", 1024);
+    EXPECT_THROW(r.Decode("../../datasets/files/test_encoded.txt", "../../datasets/configurations/private_key"), std::invalid_argument);
+}
+
+TEST(RSA, rsa_test_parallel_chunks) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    r.GenerateKeys("../../datasets/configurations/", 512);
+    auto source{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin")).get_text()};
+
+    for (std::size_t threads : {1, 3, 8}) {
+        for (auto mode : {s21::RSAMode::kByte, s21::RSAMode::kBlock}) {
+            for (auto format : {s21::RSAFormat::kBinary, s21::RSAFormat::kText}) {
+                r.SetThreads(threads);
+                r.Encode("../../datasets/files/test_binary.bin", "../../datasets/configurations/public_key", mode, format);
+                r.SetThreads(11 - threads);
+                r.Decode("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/private_key");
+                EXPECT_EQ(fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin")).get_text(), source);
+            }
+        }
+    }
+}
+
+TEST(RSA, rsa_test_envelope) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    r.GenerateKeys("../../datasets/configurations/", 1024);
+
+    for (const char* name : {"test.txt", "test_binary.bin"}) {
+        std::string path{std::string("../../datasets/files/") + name};
+        std::string stem{path.substr(0, path.find_last_of("."))}, extension{path.substr(path.find_last_of("."))};
+        auto source{fsm_.read_file(fs::path(path)).get_text()};
+
+        r.EncodeEnvelope(path, "../../datasets/configurations/public_key");
+        auto encoded{fsm_.read_file(fs::path(stem + "_encoded" + extension)).get_text()};
+        EXPECT_TRUE(s21::RSAEnvelope::IsEnvelope(encoded));
+        EXPECT_LT(encoded.size(), source.size() + 256);
+
+        r.DecodeEnvelope(stem + "_encoded" + extension, "../../datasets/configurations/private_key");
+        EXPECT_EQ(fsm_.read_file(fs::path(stem + "_encoded_decoded" + extension)).get_text(), source);
+
+        r.Decode(stem + "_encoded" + extension, "../../datasets/configurations/private_key");
+        EXPECT_EQ(fsm_.read_file(fs::path(stem + "_encoded_decoded" + extension)).get_text(), source);
+    }
+
+    EXPECT_THROW(r.DecodeEnvelope("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/public_key"), std::invalid_argument);
+    EXPECT_THROW(r.DecodeEnvelope("../../datasets/files/test_binary.bin", "../../datasets/configurations/private_key"), std::invalid_argument);
+
+    r.GenerateKeys("../../datasets/configurations/", 256);
+    EXPECT_THROW(r.EncodeEnvelope("../../datasets/files/test.txt", "../../datasets/configurations/public_key"), std::invalid_argument);
+}
+
+TEST(RSA, rsa_test_legacy_small_key) {
+    s21::RSA r;
+    tools::filesystem::monitoring fsm_;
+    fsm_.create_file(tools::filesystem::file_t(fs::path("../../datasets/configurations/public_key"), std::string("17 3233")));
+    fsm_.create_file(tools::filesystem::file_t(fs::path("../../datasets/configurations/private_key"), std::string("2753 3233")));
+
+    r.Encode("../../datasets/files/test_binary.bin", "../../datasets/configurations/public_key");
+    r.Decode("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/private_key");
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+}
+
 TEST(DES, des_test_simple_file) {
     s21::DES d;
     d.EncodeECB("../../datasets/files/test.txt", "../../datasets/configurations/des_key.txt");
@@ -101,6 +615,284 @@ TEST(DES, des_test_simple_file) {
     EXPECT_EQ(file_a.get_text(), file_b.get_text());
 }
 
+TEST(DES, des_test_block_core_known_answer) {
+    auto schedule{s21::DESCore::GenerateSchedule(0x133457799BBCDFF1ULL)};
+    uint64_t encrypted{s21::DESCore::Crypt(0x0123456789ABCDEFULL, schedule)};
+    EXPECT_EQ(encrypted, 0x85E813540F0AB405ULL);
+    EXPECT_EQ(s21::DESCore::Crypt(encrypted, s21::DESCore::ReverseSchedule(schedule)), 0x0123456789ABCDEFULL);
+}
+
+TEST(DES, des_test_block_core_published_vectors) {
+    struct Vector {
+        uint64_t key, plain, cipher;
+    };
+
+    // published single-DES vectors (FIPS 81 appendix B, NBS SP 500-20)
+    const Vector vectors[]{
+        {0x0E329232EA6D0D73ULL, 0x8787878787878787ULL, 0x0000000000000000ULL},
+        {0x0101010101010101ULL, 0x95F8A5E5DD31D900ULL, 0x8000000000000000ULL},
+        {0x0123456789ABCDEFULL, 0x4E6F772069732074ULL, 0x3FA40E8A984D4815ULL},
+    };
+
+    for (const auto& vector : vectors) {
+        auto schedule{s21::DESCore::GenerateSchedule(vector.key)};
+        uint64_t blocks[64];
+        std::fill(std::begin(blocks), std::end(blocks), vector.plain);
+        s21::DESBitslice::Crypt64(blocks, 64, schedule);
+
+        EXPECT_EQ(s21::DESCore::Crypt(vector.plain, schedule), vector.cipher);
+        EXPECT_EQ(blocks[63], vector.cipher);
+    }
+
+    char bytes[s21::DESCore::block_size];
+    s21::DESCore::Store(0x0123456789ABCDEFULL, bytes);
+    EXPECT_EQ(bytes[0], '\x01');
+    EXPECT_EQ(s21::DESCore::Load(bytes, 2), 0x0123000000000000ULL);
+}
+
+TEST(DES, des_test_key_cache) {
+    s21::DESKeyCache cache(2);
+    auto key_a{cache.Get(uint64_t{0x133457799BBCDFF1ULL})};
+    auto key_b{cache.Get(std::string_view("0001001100110100010101110111100110011011101111001101111111110001"))};
+    EXPECT_EQ(key_a, key_b);
+    EXPECT_EQ(key_a->DecryptSchedule(), s21::DESCore::ReverseSchedule(key_a->EncryptSchedule()));
+    cache.Get(uint64_t{1});
+    cache.Get(uint64_t{2});
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_NE(cache.Get(uint64_t{0x133457799BBCDFF1ULL}), key_a);
+}
+
+TEST(DES, des_test_binary_file) {
+    s21::DES d;
+    d.EncodeECB("../../datasets/files/test_binary.bin", "../../datasets/configurations/des_key.txt");
+    d.DecodeECB("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/des_key.txt");
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+    auto file_c{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded.bin"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    EXPECT_EQ(file_c.size(), s21::DESContainer::header_size + (file_a.size() / 8 + 1) * 8);
+}
+
+TEST(DES, des_test_text_format) {
+    s21::DES d;
+    d.EncodeECB("../../datasets/files/test.txt", "../../datasets/configurations/des_key.txt", s21::DESFormat::kText);
+    d.DecodeECB("../../datasets/files/test_encoded.txt", "../../datasets/configurations/des_key.txt");
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    auto file_c{fsm_.read_file(fs::path("../../datasets/files/test_encoded.txt"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    EXPECT_EQ(file_c.size(), (file_a.size() + 7) / 8 * 64);
+}
+
+TEST(DES, des_test_ecb_rejects_no_padding) {
+    s21::DES d;
+    EXPECT_THROW(d.EncodeECB("../../datasets/files/test.txt", "../../datasets/configurations/des_key.txt",
+                             s21::DESFormat::kBinary, s21::DESPadding::kNone),
+                 std::invalid_argument);
+}
+
+TEST(DES, des_test_ctr_binary_file) {
+    s21::DES d;
+    d.SetThreads(4);
+    d.EncodeCTR("../../datasets/files/test_binary.bin", "../../datasets/configurations/des_key.txt");
+    d.DecodeCTR("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/des_key.txt");
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+}
+
+TEST(DES, des_test_parallel_modes) {
+    s21::DESKey key(0x133457799BBCDFF1ULL);
+    std::string text(100003, '\0');
+    for (std::size_t i{}; i < text.size(); ++i)
+        text[i] = static_cast<char>(i * 131 + 7);
+
+    std::size_t blocks{text.size() / 8};
+    std::string serial(blocks * 8, '\0'), parallel(blocks * 8, '\0');
+    s21::DESModes::CryptECB(text.data(), serial.data(), blocks, key.EncryptSchedule(), 1);
+    s21::DESModes::CryptECB(text.data(), parallel.data(), blocks, key.EncryptSchedule(), 7);
+    EXPECT_EQ(serial, parallel);
+
+    std::string stream(text.size(), '\0');
+    s21::DESModes::CryptCTR(text.data(), stream.data(), text.size(), 0, 42, key.EncryptSchedule(), 5);
+
+    std::string chunk(1000, '\0');
+    s21::DESModes::CryptCTR(text.data() + 12345, chunk.data(), chunk.size(), 12345, 42, key.EncryptSchedule(), 1);
+    EXPECT_EQ(chunk, stream.substr(12345, chunk.size()));
+
+    s21::DESModes::CryptCTR(stream.data(), stream.data(), stream.size(), 0, 42, key.EncryptSchedule(), 3);
+    EXPECT_EQ(stream, text);
+}
+
+TEST(DES, des_test_cbc_multiple_files) {
+    s21::DES d;
+    d.EncodeCBC(std::vector<std::string>{"../../datasets/files/test.txt", "../../datasets/files/test_binary.bin"},
+                "../../datasets/configurations/des_key.txt");
+    d.DecodeCBC("../../datasets/files/test_encoded.txt", "../../datasets/configurations/des_key.txt");
+    d.DecodeCBC("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/des_key.txt");
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    auto file_c{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+    auto file_d{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    EXPECT_EQ(file_c.get_text(), file_d.get_text());
+}
+
+TEST(DES, des_test_cbc_lanes) {
+    s21::DESKey key(0x133457799BBCDFF1ULL);
+    std::vector<std::string> plain{std::string(80, 'a'), std::string(8, 'b'), std::string(), std::string(80000, 'c'), std::string(24, 'd')};
+    std::vector<std::string> cipher{plain};
+    std::vector<s21::DESModes::CBCLane> lanes;
+    for (std::size_t i{}; i < cipher.size(); ++i)
+        lanes.push_back({cipher[i].data(), cipher[i].size() / 8, i});
+
+    s21::DESModes::EncryptCBC(lanes, key.EncryptSchedule(), 2);
+
+    for (std::size_t i{}; i < cipher.size(); ++i) {
+        uint64_t previous{i};
+        for (std::size_t j{}; j < cipher[i].size(); j += 8) {
+            previous = s21::DESCore::Crypt(s21::DESCore::Load(plain[i].data() + j, 8) ^ previous, key.EncryptSchedule());
+            EXPECT_EQ(s21::DESCore::Load(cipher[i].data() + j, 8), previous);
+        }
+
+        std::string decrypted(cipher[i].size(), '\0');
+        s21::DESModes::DecryptCBC(cipher[i].data(), decrypted.data(), cipher[i].size() / 8, i, key.DecryptSchedule(), 3);
+        EXPECT_EQ(decrypted, plain[i]);
+    }
+}
+
+TEST(DES, des_test_bitslice_backends) {
+    s21::DESKey key(0x133457799BBCDFF1ULL);
+    std::vector<uint64_t> blocks(s21::DESBitslice::batch_256);
+    for (std::size_t i{}; i < blocks.size(); ++i)
+        blocks[i] = i * 0x9E3779B97F4A7C15ULL;
+
+    for (auto backend : {s21::DESBackend::kBitslice64, s21::DESBackend::kBitslice256, s21::DESBackend::kAuto}) {
+        std::size_t batch{s21::DESBitslice::BatchSize(backend)};
+        for (std::size_t count : {batch, batch - 5, std::size_t{1}}) {
+            std::vector<uint64_t> encrypted{blocks};
+            s21::DESBitslice::Crypt(backend, encrypted.data(), count, key.EncryptSchedule());
+            for (std::size_t i{}; i < encrypted.size(); ++i)
+                EXPECT_EQ(encrypted[i], i < count ? s21::DESCore::Crypt(blocks[i], key.EncryptSchedule()) : blocks[i]);
+
+            s21::DESBitslice::Crypt(backend, encrypted.data(), count, key.DecryptSchedule());
+            EXPECT_EQ(encrypted, blocks);
+        }
+    }
+
+    std::string text(30011, '\0');
+    for (std::size_t i{}; i < text.size(); ++i)
+        text[i] = static_cast<char>(i * 31 + 3);
+
+    std::string scalar_ecb(text.size() / 8 * 8, '\0'), scalar_ctr(text.size(), '\0');
+    s21::DESModes::CryptECB(text.data(), scalar_ecb.data(), text.size() / 8, key.EncryptSchedule(), 1, s21::DESBackend::kScalar);
+    s21::DESModes::CryptCTR(text.data(), scalar_ctr.data(), text.size(), 3, 7, key.EncryptSchedule(), 1, s21::DESBackend::kScalar);
+
+    for (auto backend : {s21::DESBackend::kBitslice64, s21::DESBackend::kBitslice256}) {
+        std::string ecb(scalar_ecb.size(), '\0'), ctr(text.size(), '\0'), cbc(scalar_ecb.size(), '\0');
+        s21::DESModes::CryptECB(text.data(), ecb.data(), text.size() / 8, key.EncryptSchedule(), 2, backend);
+        s21::DESModes::CryptCTR(text.data(), ctr.data(), text.size(), 3, 7, key.EncryptSchedule(), 2, backend);
+        EXPECT_EQ(ecb, scalar_ecb);
+        EXPECT_EQ(ctr, scalar_ctr);
+
+        s21::DESModes::DecryptCBC(ecb.data(), cbc.data(), ecb.size() / 8, 0, key.DecryptSchedule(), 2, backend);
+        std::string expected(cbc.size(), '\0');
+        s21::DESModes::DecryptCBC(ecb.data(), expected.data(), ecb.size() / 8, 0, key.DecryptSchedule(), 1, s21::DESBackend::kScalar);
+        EXPECT_EQ(cbc, expected);
+    }
+}
+
+TEST(DES, des_test_triple_des_core) {
+    uint64_t k1{0x0123456789ABCDEFULL}, k2{0x23456789ABCDEF01ULL}, k3{0x456789ABCDEF0123ULL};
+    s21::DES3Key key(k1, k2, k3);
+    s21::DESKey a(k1), b(k2), c(k3);
+
+    for (uint64_t block : {0x0ULL, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL}) {
+        uint64_t expected{s21::DESCore::Crypt(s21::DESCore::Crypt(s21::DESCore::Crypt(block, a.EncryptSchedule()), b.DecryptSchedule()), c.EncryptSchedule())};
+        EXPECT_EQ(s21::DESCore::Crypt(block, key.EncryptSchedule()), expected);
+        EXPECT_EQ(s21::DESCore::Crypt(expected, key.DecryptSchedule()), block);
+    }
+
+    // NIST SP 800-67 TDEA example
+    const std::string plain{"The qufck brown fox jump"};
+    const uint64_t cipher[]{0xA826FD8CE53B855FULL, 0xCCE21C8112256FE6ULL, 0x68D5C05DD9B6B900ULL};
+
+    for (std::size_t i{}; i < 3; ++i) {
+        uint64_t block{s21::DESCore::Load(plain.data() + i * s21::DESCore::block_size, s21::DESCore::block_size)};
+        EXPECT_EQ(s21::DESCore::Crypt(block, key.EncryptSchedule()), cipher[i]);
+        EXPECT_EQ(s21::DESCore::Crypt(cipher[i], key.DecryptSchedule()), block);
+    }
+
+    s21::DES3Key single{s21::DES3Key::Parse(std::string(64, '1'))};
+    s21::DESKey des(~0ULL);
+    EXPECT_EQ(s21::DESCore::Crypt(0x0123456789ABCDEFULL, single.EncryptSchedule()), s21::DESCore::Crypt(0x0123456789ABCDEFULL, des.EncryptSchedule()));
+    EXPECT_THROW(s21::DES3Key::Parse(std::string(100, '0')), std::invalid_argument);
+
+    std::vector<uint64_t> blocks(s21::DESBitslice::batch_256);
+    for (std::size_t i{}; i < blocks.size(); ++i)
+        blocks[i] = i * 0x9E3779B97F4A7C15ULL;
+
+    for (auto backend : {s21::DESBackend::kBitslice64, s21::DESBackend::kBitslice256}) {
+        std::vector<uint64_t> encrypted{blocks};
+        std::size_t count{s21::DESBitslice::BatchSize(backend)};
+        s21::DESBitslice::Crypt(backend, encrypted.data(), count, key.EncryptSchedule());
+        for (std::size_t i{}; i < count; ++i)
+            EXPECT_EQ(encrypted[i], s21::DESCore::Crypt(blocks[i], key.EncryptSchedule()));
+    }
+}
+
+TEST(DES, des_test_triple_des_file) {
+    s21::DES d;
+    tools::filesystem::monitoring fsm_;
+    s21::DES3Key key{d.LoadKey3DES("../../datasets/configurations/des3_key.txt")};
+
+    d.EncodeECB("../../datasets/files/test_binary.bin", key);
+    d.DecodeECB("../../datasets/files/test_binary_encoded.bin", key);
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+    auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+    EXPECT_EQ(file_a.get_text(), file_b.get_text());
+
+    d.EncodeCBC("../../datasets/files/test.txt", key);
+    d.DecodeCBC("../../datasets/files/test_encoded.txt", key);
+    auto file_c{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+    auto file_d{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    EXPECT_EQ(file_c.get_text(), file_d.get_text());
+
+    EXPECT_THROW(d.DecodeCBC("../../datasets/files/test_encoded.txt", "../../datasets/configurations/des_key.txt"), std::invalid_argument);
+}
+
+TEST(DES, des_test_stream_modes) {
+    s21::DES d;
+    d.SetStreamWindow(4100);
+    EXPECT_EQ(d.GetStreamWindow(), 4096);
+    tools::filesystem::monitoring fsm_;
+    auto file_a{fsm_.read_file(fs::path("../../datasets/files/test_binary.bin"))};
+
+    for (auto mode : {s21::DESMode::kECB, s21::DESMode::kCTR, s21::DESMode::kCBC}) {
+        d.EncodeStream("../../datasets/files/test_binary.bin", "../../datasets/configurations/des_key.txt", mode);
+        d.DecodeStream("../../datasets/files/test_binary_encoded.bin", "../../datasets/configurations/des_key.txt");
+        auto file_b{fsm_.read_file(fs::path("../../datasets/files/test_binary_encoded_decoded.bin"))};
+        EXPECT_EQ(file_a.get_text(), file_b.get_text());
+    }
+
+    d.EncodeStream("../../datasets/files/test.txt", "../../datasets/configurations/des_key.txt", s21::DESMode::kCBC);
+    d.DecodeCBC("../../datasets/files/test_encoded.txt", "../../datasets/configurations/des_key.txt");
+    auto file_c{fsm_.read_file(fs::path("../../datasets/files/test.txt"))};
+    auto file_d{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    EXPECT_EQ(file_c.get_text(), file_d.get_text());
+
+    s21::DES3Key key{d.LoadKey3DES("../../datasets/configurations/des3_key.txt")};
+    d.EncodeECB("../../datasets/files/test.txt", key);
+    d.DecodeStream("../../datasets/files/test_encoded.txt", key);
+    auto file_e{fsm_.read_file(fs::path("../../datasets/files/test_encoded_decoded.txt"))};
+    EXPECT_EQ(file_c.get_text(), file_e.get_text());
+    EXPECT_THROW(d.DecodeStream("../../datasets/files/test_encoded.txt", "../../datasets/configurations/des_key.txt"), std::invalid_argument);
+}
+
 int main(int argc, char* argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();